@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+
+namespace batch {
+
+// A single surface request read from a batch input file (a contract is
+// represented as a 1 x 1 surface with equal lower and upper bounds)
+struct BatchJob {
+  std::uint64_t index_{0};  // position of the job in the input file
+  Eigen::Index nSigma_{1};
+  Eigen::Index nStrike_{1};
+  double spot_{0.0};
+  double r_{0.0};
+  double q_{0.0};
+  double sigmaLo_{0.0};
+  double sigmaHi_{0.0};
+  double strikeLo_{0.0};
+  double strikeHi_{0.0};
+  double tau_{0.0};
+};
+
+}  // namespace batch
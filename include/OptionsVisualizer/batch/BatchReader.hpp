@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+
+namespace batch {
+
+// Streaming reader for batch input files. Each non-empty line that doesn't
+// start with '#' is either a surface (10 comma-separated fields: n_sigma,
+// n_strike, spot, r, q, sigma_lo, sigma_hi, strike_lo, strike_hi, tau) or a
+// single contract (6 fields: spot, strike, r, q, sigma, tau). Lines are parsed
+// on demand so the whole file is never held in memory, and `next` may be
+// called from several threads at once
+class BatchReader {
+  // --- Data members
+  std::ifstream in_;
+  std::mutex mutex_{};
+  std::string line_{};
+  std::size_t lineNo_{0};
+  std::uint64_t nJobs_{0};
+
+ public:
+  explicit BatchReader(const std::string& path);
+
+  // Retrieve the next job in the file (empty once the file is exhausted)
+  [[nodiscard]] std::optional<BatchJob> next();
+
+ private:
+  // Parse a single line of the input file into a job
+  [[nodiscard]] BatchJob parseLine() const;
+};
+
+}  // namespace batch
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+
+namespace batch {
+
+// Precision used to store grid values in the output file
+enum class ValueFormat : std::uint8_t { Float64, Float32 };
+
+// Streaming writer for batch results. The file starts with a fixed header
+// (magic "OVPB", format version, value width in bytes, number of option types
+// and number of greek types) followed by one record per job in completion
+// order. Each record holds the job's input index, grid shape and parameters
+// followed by every grid (option type major, then greek type) stored in
+// column-major order. Records are flushed as soon as they are written so
+// memory usage doesn't grow with the size of the batch
+class BatchWriter {
+  using GridArray = GridBlock;
+
+  // --- Data members
+  std::ofstream out_;
+  std::mutex mutex_{};
+  ValueFormat format_;
+
+ public:
+  explicit BatchWriter(const std::string& path, ValueFormat format);
+
+  // Append the results of a job to the output file (thread-safe)
+  void write(const BatchJob& job, const GridArray& grids);
+
+ private:
+  template <typename T>
+  void writeRaw(const T& value) {
+    out_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+};
+
+}  // namespace batch
@@ -13,6 +13,9 @@ enum class GreekType : std::uint8_t {
   Vega,
   Theta,
   Rho,
+  Vanna,  // d(delta) / d(sigma)
+  Volga,  // d(vega) / d(sigma)
+  Charm,  // d(delta) / dt (delta decay)
   COUNT
 };
 
@@ -25,6 +28,34 @@ enum class OptionType : std::uint8_t {
   COUNT
 };
 
+// Enum for choosing how the points of a sigma or strike axis are spread
+enum class AxisSpacing : std::uint8_t {
+  Linear,     // evenly spaced
+  Log,        // evenly spaced in log (denser towards the low end)
+  Chebyshev,  // Chebyshev-Lobatto points (denser towards both ends)
+};
+
+// Enum for choosing how the surface cache admits and evicts entries
+enum class CachePolicy : std::uint8_t {
+  LRU,      // evict the least recently used entry
+  TinyLFU,  // W-TinyLFU admission with eviction weighted by recompute cost
+};
+
+// Enum for choosing which CPUs the pricing threads are pinned to
+enum class ThreadAffinity : std::uint8_t {
+  Off,   // let the OS schedule them anywhere
+  Core,  // one CPU per thread
+  Node,  // every CPU of one NUMA node per thread
+};
+
+// Enum for choosing how heatmap values are handed to the plotting layer
+enum class HeatmapEncoding : std::uint8_t {
+  Float64,  // the engine's values (no copy)
+  Float32,  // single precision copies
+  UInt16,   // 16-bit codes over the greek's color range
+  UInt8,    // 8-bit codes over the greek's color range
+};
+
 [[nodiscard]] constexpr std::size_t idx(const OptionType o) noexcept {
   return static_cast<std::size_t>(o);
 }
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <memory>
+
+#include "OptionsVisualizer/core/globals.hpp"
+
+// Every grid of a surface in one contiguous allocation. Grids are stored back
+// to back in `optIdx * nGreeks + greekIdx` order, each in column-major order
+// (sigma rows, strike columns) and starting on a cache line boundary, so the
+// block is an (option type, greek, sigma, strike) tensor that can be handed
+// out whole without copying. Shared-memory segments use the same layout (see
+// ipc::SharedGrids)
+class GridBlock {
+ public:
+  using Grid = Eigen::Map<Eigen::ArrayXXd>;
+  using ConstGrid = Eigen::Map<const Eigen::ArrayXXd>;
+
+  // Grids start on cache line boundaries
+  static constexpr std::size_t alignment{64};
+
+  // Read-only view of a block (owned by a GridBlock or mapped from shared
+  // memory)
+  struct View {
+    const double* data_;
+    Eigen::Index nSigma_;
+    Eigen::Index nStrike_;
+    Eigen::Index gridStride_;  // doubles between the starts of two grids
+
+    [[nodiscard]] ConstGrid grid(const std::size_t idx) const noexcept {
+      return ConstGrid{data_ + static_cast<Eigen::Index>(idx) * gridStride_,
+                       nSigma_, nStrike_};
+    }
+  };
+
+ private:
+  struct Free {
+    void operator()(double* ptr) const noexcept;
+  };
+
+  // --- Data members
+  Eigen::Index nSigma_;
+  Eigen::Index nStrike_;
+  Eigen::Index gridStride_;
+  std::unique_ptr<double[], Free> data_;
+
+ public:
+  // Empty block
+  GridBlock() noexcept;
+
+  // Block of (nSigma x nStrike) grids (values are left uninitialized)
+  explicit GridBlock(Eigen::Index nSigma, Eigen::Index nStrike);
+
+  GridBlock(const GridBlock& other);
+  GridBlock& operator=(const GridBlock& other);
+  GridBlock(GridBlock&& other) noexcept;
+  GridBlock& operator=(GridBlock&& other) noexcept;
+  ~GridBlock() = default;
+
+  [[nodiscard]] Grid operator[](const std::size_t idx) noexcept {
+    return Grid{data_.get() + static_cast<Eigen::Index>(idx) * gridStride_,
+                nSigma_, nStrike_};
+  }
+
+  [[nodiscard]] ConstGrid operator[](const std::size_t idx) const noexcept {
+    return view().grid(idx);
+  }
+
+  [[nodiscard]] Eigen::Index rows() const noexcept { return nSigma_; }
+
+  [[nodiscard]] Eigen::Index cols() const noexcept { return nStrike_; }
+
+  [[nodiscard]] View view() const noexcept {
+    return View{.data_ = data_.get(),
+                .nSigma_ = nSigma_,
+                .nStrike_ = nStrike_,
+                .gridStride_ = gridStride_};
+  }
+
+  // Doubles between the starts of two grids (each grid padded to a whole
+  // number of cache lines)
+  [[nodiscard]] static Eigen::Index stride(Eigen::Index nSigma,
+                                           Eigen::Index nStrike) noexcept;
+
+ private:
+  [[nodiscard]] std::size_t size() const noexcept {
+    return static_cast<std::size_t>(gridStride_) * globals::nGrids;
+  }
+};
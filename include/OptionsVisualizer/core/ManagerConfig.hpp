@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+
+// Settings for an OptionsManager
+struct ManagerConfig {
+  std::size_t capacity_{16};  // cached parameter sets
+  std::size_t nThreads_{0};   // 0 uses every hardware thread
+
+  // CPUs the pool threads are pinned to (see Utils::threadCpus), so their
+  // scratch memory and lattice buffers stay on their NUMA node
+  Enums::ThreadAffinity affinity_{Enums::ThreadAffinity::Off};
+
+  Enums::CachePolicy cachePolicy_{Enums::CachePolicy::LRU};
+
+  // Lattice options for the American pricing trees (processes sharing a
+  // shared-memory cache should use the same settings); `partitions_` of 0
+  // splits large surfaces into one block per NUMA node
+  models::trinomial::TreeSettings tree_{};
+
+  // Compressed cold tier for entries pushed out of the cache (disabled when the
+  // capacity is 0); values are reconstructed within `coldTolerance_` times the
+  // largest magnitude of their grid
+  std::size_t coldCapacity_{0};
+  double coldTolerance_{1e-4};
+
+  // Progressive refinement (see OptionsManager::getProgressive): the preview
+  // prices every `previewStride_`-th sigma row and strike column, and the
+  // preview and intermediate stages use trees of `previewDepth_` steps
+  Eigen::Index previewStride_{4};
+  Eigen::Index previewDepth_{25};
+
+  // Submissions (see OptionsManager::submit) that share spot, r, q and tau and
+  // arrive within `coalesceMs_` milliseconds of the first one are priced as one
+  // batch of unique (sigma, strike) cells (0 prices each on its own)
+  double coalesceMs_{0.0};
+
+  // Surfaces priced in the background right after construction, at the lowest
+  // pool priority so requests overtake them (e.g. the default view and its
+  // neighbors, so the first user after a restart hits the cache)
+  std::vector<SurfaceSpec> warmup_{};
+
+  // Host-wide shared-memory cache (disabled when the name is empty)
+  std::string sharedCache_{};
+  std::size_t sharedCapacity_{64};
+};
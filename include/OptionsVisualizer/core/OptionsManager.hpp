@@ -3,40 +3,276 @@
 #include <BS_thread_pool.hpp>
 #include <Eigen/Dense>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
 #include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/ipc/SharedCache.hpp"
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+#include "OptionsVisualizer/lru/CompressedGrids.hpp"
 #include "OptionsVisualizer/lru/LRUCache.hpp"
+#include "OptionsVisualizer/lru/SurfaceCache.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/Portfolio.hpp"
 #include "OptionsVisualizer/pricing/PricingParams.hpp"
+#include "OptionsVisualizer/pricing/ProgressiveSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceBatch.hpp"
+#include "OptionsVisualizer/pricing/SurfaceQueue.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
 
 // Class exported to python for generating greek results across a grid of sigma
-// x strike (it is in charge of caching results using least recently used
-// methodology and managing the thread pool). Our module actually exports the
-// raw data buffers managed by the object rather than copying the results which
-// would lead to dangling references if cached results were deleted prior to
-// python's use; however, we only view one set of results at a time so this
-// isn't a concern for this project
+// x strike (it is in charge of caching results, least recently used by default
+// or cost-aware TinyLFU, and managing the thread pool). Our module actually
+// exports the raw data buffers managed by the object rather than copying the
+// results which would lead to dangling references if cached results were
+// deleted prior to python's use; however, we only view one set of results at a
+// time so this isn't a concern for this project. Optionally, results pushed
+// out of the cache are kept compressed in a cold tier, and results are also
+// published to a host-wide shared-memory cache (see ipc::SharedCache) so
+// processes only price a set of parameters once between them.
+// Methods can be called from several threads at once (the bindings release the
+// GIL): the manager's state is guarded by one mutex that calls release while
+// they wait on pricing, and identical concurrent requests share one pricing.
+// References into the cache stay valid until a call evicts them, which may be
+// another thread's
 class OptionsManager {
   //--- Data members
 
-  // LRU cache
-  using GridArray = std::array<Eigen::ArrayXXd, globals::nGrids>;
-  LRUCache<PricingParams, GridArray, PricingParamsHash> lru_;
+  // Guards every member but the tree settings, the pool and the queue
+  mutable std::mutex mutex_;
+
+  // Surface cache (entries are weighted by their pricing wall time)
+  using GridArray = GridBlock;
+  SurfaceCache<PricingParams, GridArray, PricingParamsHash> cache_;
+
+  // Cold tier of compressed entries pushed out of `cache_` (unused when its
+  // capacity is 0)
+  struct ColdEntry {
+    CompressedGrids grids_;
+    double cost_;
+  };
+  LRUCache<PricingParams, ColdEntry, PricingParamsHash> cold_;
+  double coldTolerance_;
+
+  // Lattice options for the American pricing trees
+  models::trinomial::TreeSettings tree_;
+
+  // Host-wide cache and this process's mappings of its entries (both unused
+  // unless a shared cache name is given)
+  std::optional<ipc::SharedCache> shared_;
+  LRUCache<PricingParams, ipc::SharedGrids, PricingParamsHash> mapped_;
+
+  // Surfaces being refined in the background (their final grids move into the
+  // cache once they're done; each new refinement supersedes the earlier ones,
+  // which stop after their current stage unless they're requested again)
+  struct Refinement {
+    std::shared_ptr<ProgressiveSurface> surface_;
+    std::shared_future<void> done_;  // shared so it's waited on unlocked
+  };
+  std::unordered_map<PricingParams, Refinement, PricingParamsHash> refining_;
+  Eigen::Index previewStride_;
+  Eigen::Index previewDepth_;
+
+  // Surfaces submitted for asynchronous pricing (moved into the cache once
+  // they're done)
+  std::unordered_map<PricingParams, std::shared_ptr<SurfaceTask>,
+                     PricingParamsHash>
+      submitted_;
+
+  // Batches still accepting submissions (unused when the coalescing window is
+  // 0)
+  std::vector<std::shared_ptr<SurfaceBatch>> batches_;
+  double coalesceMs_;
+
+  // Surfaces being warmed up at low priority (moved into the cache once
+  // they're done; requests wait on the ones that have started and take the
+  // others out of the warm-up) and the flag that cancels the ones that haven't
+  // started
+  using WarmupList =
+      std::vector<std::pair<PricingParams, std::shared_ptr<SurfaceTask>>>;
+  WarmupList warming_;
+  std::shared_ptr<std::atomic<bool>> stopWarmup_;
 
   // Thread pool for trinomial pricing
-  BS::thread_pool<> pool_;
+  BS::priority_thread_pool pool_;
+
+  // Orchestrating threads of the submissions that aren't coalesced (as many as
+  // the pool has threads; destroyed before the pool they price on)
+  SurfaceQueue queue_;
 
  public:
+  // Read-only views of every grid for one set of parameters
+  using GridViews =
+      std::array<Eigen::Map<const Eigen::ArrayXXd>, globals::nGrids>;
+
+  // Latest stage of a progressively computed surface (`grids_` points into
+  // `owner_` for intermediate stages, and into the cache once final where it
+  // stays valid until the next call, like `get`)
+  struct Progress {
+    ProgressiveSurface::Stage stage_;
+    const GridArray* grids_;
+    std::shared_ptr<const GridArray> owner_;
+  };
+
   // Constructs a thread pool with total number of threads available on hardware
   explicit OptionsManager(std::size_t capacity);
 
   // Constructs a thread pool with a specified number of threads
   explicit OptionsManager(std::size_t capacity, std::size_t nThreads);
 
+  // Full configuration (cache policy, shared-memory cache, ...)
+  explicit OptionsManager(const ManagerConfig& config);
+
+  // Waits for background refinements and submissions (they price on `pool_`)
+  // and cancels the warm-up (no other call may still be running)
+  ~OptionsManager();
+
+  OptionsManager(const OptionsManager&) = delete;
+  OptionsManager& operator=(const OptionsManager&) = delete;
+
   // Retrieve cached greek values or compute new ones and cache the results
+  // (linearly spaced axes)
   [[nodiscard]] const GridArray& get(Eigen::Index nSigma, Eigen::Index nStrike,
                                      double spot, double r, double q,
                                      double sigmaLo, double sigmaHi,
                                      double strikeLo, double strikeHi,
                                      double tau);
+
+  // Same as above over explicit sigma and strike axes (results are cached by
+  // the axis contents)
+  [[nodiscard]] const GridArray& get(const Eigen::ArrayXd& sigmas,
+                                     const Eigen::ArrayXd& strikes,
+                                     double spot, double r, double q,
+                                     double tau);
+
+  // Same as `get` but returns views that point straight into the shared
+  // mapping when a shared cache is in use (no copy into this process)
+  [[nodiscard]] GridViews getViews(Eigen::Index nSigma, Eigen::Index nStrike,
+                                   double spot, double r, double q,
+                                   double sigmaLo, double sigmaHi,
+                                   double strikeLo, double strikeHi,
+                                   double tau);
+
+  [[nodiscard]] GridViews getViews(const Eigen::ArrayXd& sigmas,
+                                   const Eigen::ArrayXd& strikes, double spot,
+                                   double r, double q, double tau);
+
+  // Same as `getViews` as one view of the whole (option type, greek, sigma,
+  // strike) block
+  [[nodiscard]] GridBlock::View getBlock(Eigen::Index nSigma,
+                                         Eigen::Index nStrike, double spot,
+                                         double r, double q, double sigmaLo,
+                                         double sigmaHi, double strikeLo,
+                                         double strikeHi, double tau);
+
+  [[nodiscard]] GridBlock::View getBlock(const Eigen::ArrayXd& sigmas,
+                                         const Eigen::ArrayXd& strikes,
+                                         double spot, double r, double q,
+                                         double tau);
+
+  // Grids at several maturities over the same axes, spot, r and q (one block
+  // per entry of `taus`, in order, so together they form a tau x sigma x strike
+  // cube per greek and option type). Cached maturities are reused and the
+  // missing ones are priced together (see TermStructure) and cached
+  // individually. The blocks are copies, so they stay valid regardless of later
+  // calls
+  [[nodiscard]] std::vector<GridArray> getCube(
+      Eigen::Index nSigma, Eigen::Index nStrike, double spot, double r,
+      double q, double sigmaLo, double sigmaHi, double strikeLo,
+      double strikeHi, const Eigen::ArrayXd& taus);
+
+  [[nodiscard]] std::vector<GridArray> getCube(const Eigen::ArrayXd& sigmas,
+                                               const Eigen::ArrayXd& strikes,
+                                               double spot, double r, double q,
+                                               const Eigen::ArrayXd& taus);
+
+  // Revalue a book of positions over a spot x vol shock grid on the manager's
+  // pool (see Portfolio); scenarios aren't cached, so it doesn't take the lock
+  [[nodiscard]] Portfolio::Scenarios revalue(
+      const std::vector<Portfolio::Position>& positions, double spot, double r,
+      double q, double sigma, const Eigen::ArrayXd& spotShocks,
+      const Eigen::ArrayXd& volShocks);
+
+  // Progressive variant of `get`: the first call for new parameters starts a
+  // coarse-to-fine refinement in the background (superseding the refinements
+  // of other parameters) and every call returns the latest stage without
+  // blocking (cached surfaces come back final right away)
+  [[nodiscard]] Progress getProgressive(const Eigen::ArrayXd& sigmas,
+                                        const Eigen::ArrayXd& strikes,
+                                        double spot, double r, double q,
+                                        double tau);
+
+  // Asynchronous variant of `get`: returns right away with a task that prices
+  // the surface in the background (several submissions are priced
+  // concurrently by a bounded set of threads, or coalesced into one batch with
+  // ManagerConfig::coalesceMs_, identical ones share a task, and cached
+  // surfaces come back finished). The task's grids are owned by the task, so
+  // they stay valid regardless of later calls; they also move into the cache
+  // on the next call
+  [[nodiscard]] std::shared_ptr<SurfaceTask> submit(
+      const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes, double spot,
+      double r, double q, double tau);
+
+  // Hit/miss counters of the in-process surface cache (hits on the cold tier
+  // count as misses plus a cold hit)
+  [[nodiscard]] CacheStats cacheStats() const;
+
+  void resetCacheStats();
+
+  // Whether any warm-up surface is still being priced
+  [[nodiscard]] bool warmingUp() const;
+
+ private:
+  // Full configuration on a machine with the given NUMA nodes
+  explicit OptionsManager(const ManagerConfig& config,
+                          const std::vector<std::vector<int>>& nodes);
+
+  // Warm-up entry of a set of parameters (or the end of `warming_`)
+  [[nodiscard]] WarmupList::iterator findWarming(const PricingParams& params);
+
+  // Cached grids (promoting compressed entries from the cold tier) or null
+  [[nodiscard]] const GridArray* findCached(const PricingParams& params);
+
+  // `get` with the lock held by `lock`
+  [[nodiscard]] const GridArray& get(const PricingParams& params,
+                                     const SurfaceSpec& surface,
+                                     std::unique_lock<std::mutex>& lock);
+
+  // Finish a background refinement, submission or started warm-up of the same
+  // parameters rather than pricing them twice (the lock is released while
+  // waiting)
+  void awaitPending(const PricingParams& params,
+                    std::unique_lock<std::mutex>& lock);
+
+  // Price a surface on the calling thread with the lock released, as a
+  // submission that identical requests wait on in the meantime (rethrows a
+  // pricing failure)
+  [[nodiscard]] std::shared_ptr<SurfaceTask> priceUnlocked(
+      const PricingParams& params, const SurfaceSpec& surface,
+      std::unique_lock<std::mutex>& lock);
+
+  // Move every finished refinement into the cache
+  void collectRefinements();
+
+  // Move every finished submission into the cache
+  void collectSubmissions();
+
+  // Move every finished warm-up surface into the cache
+  void collectWarmup();
+
+  // Cache (and publish) priced grids unless an identical surface got there
+  // first, and return the cached grids
+  const GridArray& store(const PricingParams& params, const GridArray& grids,
+                         double cost);
 };
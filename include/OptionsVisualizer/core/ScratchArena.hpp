@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+// Thread-local bump allocator for short-lived pricing temporaries (perturbed
+// sigma grids, perturbed prices, BSM intermediates, ...). Memory is handed out
+// from a single block owned by the calling thread and released in bulk when
+// the outermost Scope on that thread ends. Requests that don't fit in the block
+// are served from the heap once and the block grows to the peak usage at the
+// end of the scope, so steady-state requests never touch the global allocator
+// and concurrent tasks never contend on it
+class ScratchArena {
+  // Cache line alignment (also satisfies Eigen's vectorization requirements)
+  static constexpr std::size_t alignment{64};
+
+  struct AlignedDelete {
+    void operator()(std::byte* ptr) const noexcept {
+      ::operator delete[](ptr, std::align_val_t{alignment});
+    }
+  };
+
+  using Block = std::unique_ptr<std::byte[], AlignedDelete>;
+
+  // --- Data members
+  Block block_{};
+  std::size_t capacity_{0};
+  std::size_t offset_{0};
+  std::size_t inUse_{0};           // bytes handed out (block and overflow)
+  std::size_t peak_{0};            // high-water mark of inUse_
+  std::vector<Block> overflow_{};  // allocations that didn't fit in block_
+  std::size_t nScopes_{0};
+
+  ScratchArena() = default;
+
+ public:
+  using ArrayMap = Eigen::Map<Eigen::ArrayXXd, Eigen::AlignedMax>;
+
+  // RAII handle marking the lifetime of scratch allocations (scopes may nest;
+  // each one rewinds the arena to where it started when it ends)
+  class Scope {
+    ScratchArena& arena_;
+    std::size_t offset_;
+    std::size_t inUse_;
+    std::size_t nOverflow_;
+
+   public:
+    Scope();
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Uninitialized scratch array valid until the end of the scope
+    [[nodiscard]] ArrayMap array(Eigen::Index rows, Eigen::Index cols);
+
+    // N uninitialized scratch arrays of the same shape
+    template <std::size_t N>
+    [[nodiscard]] std::array<ArrayMap, N> arrays(const Eigen::Index rows,
+                                                 const Eigen::Index cols) {
+      return arrays(rows, cols, std::make_index_sequence<N>{});
+    }
+
+   private:
+    template <std::size_t... IDXs>
+    [[nodiscard]] std::array<ArrayMap, sizeof...(IDXs)> arrays(
+        const Eigen::Index rows, const Eigen::Index cols,
+        std::index_sequence<IDXs...>) {
+      return {(static_cast<void>(IDXs), array(rows, cols))...};
+    }
+  };
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // Arena owned by the calling thread
+  [[nodiscard]] static ScratchArena& local();
+
+ private:
+  [[nodiscard]] double* allocate(std::size_t nDoubles);
+
+  // Free overflow allocations and grow the block to the peak usage
+  void consolidate();
+};
+
+}  // namespace Utils
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+
+namespace Utils {
+
+// CPUs this process may run on, grouped by NUMA node (read from sysfs; a single
+// node holding every allowed CPU when the topology isn't exposed)
+[[nodiscard]] std::vector<std::vector<int>> numaNodes();
+
+// CPUs that pool thread `idx` is pinned to under `affinity` (empty when
+// threads aren't pinned). Consecutive threads alternate between nodes so a pool
+// smaller than the machine still spans every socket
+[[nodiscard]] std::vector<int> threadCpus(
+    Enums::ThreadAffinity affinity, const std::vector<std::vector<int>>& nodes,
+    std::size_t idx);
+
+// Restrict the calling thread to `cpus` (no-op when empty; false if the OS
+// refused). Memory the thread touches first afterwards is placed on their node
+// by the kernel's default first-touch policy, so threads should be pinned
+// before they allocate anything
+bool pinThread(const std::vector<int>& cpus);
+
+}  // namespace Utils
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+
+// Helpers packing one greek of every option type for the heatmaps: the color
+// range the option types share and compact encodings of their grids, so the
+// plotting layer neither scans nor serializes full-precision values
+namespace heatmap {
+
+// Smallest and largest finite value (both NaN when nothing is finite)
+struct Range {
+  double min_;
+  double max_;
+};
+
+// Integer codes over a range: code c decodes to offset_ + scale_ * c
+struct Quantization {
+  double offset_;
+  double scale_;
+};
+
+// The largest code marks values that aren't finite
+template <typename Code>
+inline constexpr Code nonFinite{std::numeric_limits<Code>::max()};
+
+// Color range of one greek across every option type
+[[nodiscard]] Range greekRange(const GridBlock::View& block,
+                               Enums::GreekType greekType);
+
+// Write a grid's values in single precision in column-major order
+void narrow(const GridBlock::ConstGrid& grid, float* out);
+
+// Codes spanning `range` (every code decodes to the minimum when the range is
+// empty or not finite)
+template <typename Code>
+[[nodiscard]] Quantization quantization(const Range& range) noexcept {
+  constexpr double maxCode{static_cast<double>(nonFinite<Code>) - 1.0};
+  const double span{range.max_ - range.min_};
+  return Quantization{
+      .offset_ = std::isfinite(range.min_) ? range.min_ : 0.0,
+      .scale_ = std::isfinite(span) && span > 0.0 ? span / maxCode : 0.0};
+}
+
+// Write a grid's codes in column-major order (rounded to the nearest code, so
+// values are off by at most half a step)
+template <typename Code>
+void quantize(const GridBlock::ConstGrid& grid, const Quantization& q,
+              Code* const out) {
+  constexpr double maxCode{static_cast<double>(nonFinite<Code>) - 1.0};
+
+  for (Eigen::Index idx{0}; idx < grid.size(); ++idx) {
+    const double value{grid.data()[idx]};
+
+    if (!std::isfinite(value)) {
+      out[idx] = nonFinite<Code>;
+    } else if (q.scale_ > 0.0) {
+      const double code{std::round((value - q.offset_) / q.scale_)};
+      out[idx] = static_cast<Code>(std::clamp(code, 0.0, maxCode));
+    } else {
+      out[idx] = Code{0};
+    }
+  }
+}
+
+}  // namespace heatmap
@@ -2,6 +2,21 @@
 
 #include <Eigen/Dense>
 
+#include "OptionsVisualizer/core/Enums.hpp"
+
 // Exported function for generating linearly separated points of size `size`
 // between lo and hi (allowing for consistency between python and C++)
 [[nodiscard]] Eigen::ArrayXd linspace(Eigen::Index size, double lo, double hi);
+
+// Points of size `size` between lo and hi that are evenly spaced in log (both
+// bounds must be positive)
+[[nodiscard]] Eigen::ArrayXd logspace(Eigen::Index size, double lo, double hi);
+
+// Chebyshev-Lobatto points of size `size` between lo and hi in ascending order
+// (includes both bounds)
+[[nodiscard]] Eigen::ArrayXd chebspace(Eigen::Index size, double lo, double hi);
+
+// Exported function for generating an axis of size `size` between lo and hi
+// with the given spacing
+[[nodiscard]] Eigen::ArrayXd makeAxis(Enums::AxisSpacing spacing,
+                                      Eigen::Index size, double lo, double hi);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc {
+
+// Wire format used between the pricing daemon and its clients over a Unix
+// domain socket. Both ends run on the same host, so messages are fixed-size
+// structs in native byte order. Each request is answered by exactly one
+// response naming the shared-memory segment (see SharedGrids) holding the
+// results
+inline constexpr std::uint32_t protocolMagic{0x4f565044};  // "OVPD"
+inline constexpr std::uint32_t protocolVersion{1};
+
+struct DaemonRequest {
+  std::uint32_t magic_;
+  std::uint32_t version_;
+  std::int64_t nSigma_;
+  std::int64_t nStrike_;
+  double spot_;
+  double r_;
+  double q_;
+  double sigmaLo_;
+  double sigmaHi_;
+  double strikeLo_;
+  double strikeHi_;
+  double tau_;
+};
+
+enum class DaemonStatus : std::int32_t { Ok, BadRequest, PricingError };
+
+struct DaemonResponse {
+  static constexpr std::size_t maxNameLength{64};
+  static constexpr std::size_t maxErrorLength{192};
+
+  std::uint32_t magic_;
+  DaemonStatus status_;
+  std::array<char, maxNameLength> segment_;  // null-terminated segment name
+  std::array<char, maxErrorLength> error_;   // null-terminated error message
+};
+
+}  // namespace ipc
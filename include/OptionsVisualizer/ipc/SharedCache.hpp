@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingParams.hpp"
+
+namespace ipc {
+
+// Result cache shared by every process on the host. A small index segment
+// (`<name>-index`) maps PricingParamsHash values (and the full quantized
+// parameters to rule out collisions, plus the tree settings they were priced
+// with so processes using different lattices never share results) to data
+// segments (`<name>-<id>`, see SharedGrids) and is protected by a
+// process-shared robust mutex, so a process that dies while holding the lock
+// can't wedge the others. Any process can publish a computed set of grids and
+// every other process maps it read-only.
+// The cache outlives the processes using it (see `destroy`)
+class SharedCache {
+  using GridArray = GridBlock;
+
+  struct IndexHeader;
+  struct IndexSlot;
+
+  // Tree settings that change the prices (depth, bit pattern of the
+  // truncation, early-exercise skipping and the control variate)
+  using Settings = std::array<std::int64_t, 4>;
+
+  // --- Data members
+  std::string name_;
+  Settings settings_;
+  IndexHeader* index_;
+  std::size_t indexSize_;
+
+ public:
+  // Attach to the cache called `name` (must start with '/'), creating it with
+  // room for `capacity` entries if it doesn't exist yet. Lookups and
+  // publications are scoped to results priced with `settings`
+  explicit SharedCache(std::string name, std::size_t capacity,
+                       const models::trinomial::TreeSettings& settings = {});
+
+  SharedCache(const SharedCache&) = delete;
+  SharedCache& operator=(const SharedCache&) = delete;
+  ~SharedCache();
+
+  // Map the published results for a set of parameters (if any)
+  [[nodiscard]] std::optional<SharedGrids> find(const PricingParams& params);
+
+  // Publish results, evicting the least recently used entry if the index is
+  // full, and return a mapping of the published segment (if another process
+  // published the same parameters first, theirs is returned instead)
+  [[nodiscard]] SharedGrids publish(const PricingParams& params,
+                                    const GridArray& grids);
+
+  // Unlink the index and every data segment of the cache called `name`
+  static void destroy(const std::string& name);
+
+ private:
+  [[nodiscard]] std::string segmentName(std::uint64_t id) const;
+
+  [[nodiscard]] IndexSlot* slots() const noexcept;
+
+  // Index hash of `params` priced with this handle's settings
+  [[nodiscard]] std::size_t hash(const PricingParams& params) const noexcept;
+
+  // Slot holding `params` (nullptr if not cached); caller must hold the lock
+  [[nodiscard]] IndexSlot* findSlot(const PricingParams& params,
+                                    std::size_t hash) const noexcept;
+};
+
+}  // namespace ipc
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+
+namespace ipc {
+
+// Layout of a shared-memory segment holding every grid for one set of pricing
+// parameters: this header followed by the grids (option type major, then greek
+// type), each stored in column-major order starting on a 64-byte boundary
+// (the same layout as a GridBlock)
+struct SegmentHeader {
+  static constexpr std::uint32_t expectedMagic{0x4f565347};  // "OVSG"
+  static constexpr std::uint32_t expectedVersion{1};
+
+  std::uint32_t magic_;
+  std::uint32_t version_;
+  std::int64_t nSigma_;
+  std::int64_t nStrike_;
+  std::uint64_t nGrids_;
+  std::uint64_t dataOffset_;  // bytes from the segment start to the first grid
+  std::uint64_t gridStride_;  // bytes between consecutive grids
+};
+
+// RAII handle to a POSIX shared-memory segment holding a set of grids. The
+// process that creates a segment owns its name and unlinks it on destruction;
+// existing mappings in other processes stay valid until they are unmapped
+class SharedGrids {
+  using GridArray = GridBlock;
+
+  // --- Data members
+  std::string name_;
+  std::byte* addr_;
+  std::size_t size_;
+  bool owner_;
+
+  SharedGrids(std::string name, std::byte* addr, std::size_t size, bool owner);
+
+ public:
+  // Create a new segment named `name` (must start with '/') and copy the grids
+  // into it (throws if the segment already exists)
+  [[nodiscard]] static SharedGrids create(const std::string& name,
+                                          const GridArray& grids);
+
+  // Map an existing segment read-only
+  [[nodiscard]] static SharedGrids open(const std::string& name);
+
+  SharedGrids(SharedGrids&& other) noexcept;
+  SharedGrids& operator=(SharedGrids&& other) noexcept;
+  SharedGrids(const SharedGrids&) = delete;
+  SharedGrids& operator=(const SharedGrids&) = delete;
+  ~SharedGrids();
+
+  [[nodiscard]] const std::string& name() const noexcept { return name_; }
+
+  [[nodiscard]] const SegmentHeader& header() const noexcept;
+
+  // Read-only view of a single grid in the segment
+  [[nodiscard]] Eigen::Map<const Eigen::ArrayXXd> grid(std::size_t idx) const;
+
+  // Read-only view of every grid in the segment
+  [[nodiscard]] GridBlock::View view() const noexcept;
+
+  // Copy every grid out of the segment
+  [[nodiscard]] GridArray toGrids() const;
+
+  // Give up ownership of the name so the segment outlives this handle (someone
+  // else becomes responsible for unlinking it)
+  void disown() noexcept { owner_ = false; }
+
+  // Remove a segment name (existing mappings stay valid)
+  static void unlink(const std::string& name) noexcept;
+
+ private:
+  void release() noexcept;
+};
+
+}  // namespace ipc
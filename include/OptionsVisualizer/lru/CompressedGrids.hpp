@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+
+// Lossy, compact copy of a set of grids for the cold cache tier. Each grid is
+// stored with the narrowest encoding whose worst-case error stays within
+// `tolerance` times the grid's largest magnitude: 16-bit linear quantization
+// over the grid's [min, max] range (smooth surfaces almost always qualify),
+// then float, then the raw doubles
+class CompressedGrids {
+  using GridArray = GridBlock;
+
+  enum class Encoding : std::uint8_t { Quantized16, Float32, Float64 };
+
+  struct Grid {
+    Encoding encoding_;
+    double offset_;  // value of code 0 (Quantized16)
+    double step_;    // value per code (Quantized16)
+    std::vector<std::byte> bytes_;
+  };
+
+  // --- Data members
+  Eigen::Index nSigma_;
+  Eigen::Index nStrike_;
+  std::array<Grid, globals::nGrids> grids_;
+
+ public:
+  explicit CompressedGrids(const GridArray& grids, double tolerance);
+
+  // Reconstruct every grid
+  [[nodiscard]] GridArray decompress() const;
+
+  // Bytes held by the encoded grids
+  [[nodiscard]] std::size_t size() const noexcept;
+
+ private:
+  [[nodiscard]] static Grid encode(const GridBlock::ConstGrid& grid,
+                                   double tolerance);
+
+  static void decode(const Grid& grid, GridBlock::Grid out);
+};
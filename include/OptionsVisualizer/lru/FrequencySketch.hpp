@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Count-min sketch of 4-bit access counters used by TinyLFU to estimate how
+// often a key has been requested recently. Counters are halved every
+// `sampleSize_` increments so old popularity fades
+class FrequencySketch {
+  static constexpr std::size_t nRows{4};
+  static constexpr std::uint8_t maxCount{15};
+
+  // --- Data members
+  std::vector<std::uint8_t> counters_;
+  std::size_t mask_;
+  std::size_t sampleSize_;
+  std::size_t nIncrements_{0};
+
+  // Counter index for one row (each row mixes the hash with its own seed)
+  [[nodiscard]] std::size_t index(const std::size_t hash,
+                                  const std::size_t row) const noexcept {
+    static constexpr std::uint64_t seeds[nRows]{
+        0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL,
+        0x27d4eb2f165667c5ULL};
+    std::uint64_t h{(static_cast<std::uint64_t>(hash) + seeds[row]) *
+                    0xff51afd7ed558ccdULL};
+    h ^= h >> 32;
+    return row * (mask_ + 1) + (static_cast<std::size_t>(h) & mask_);
+  }
+
+ public:
+  // Sized for a cache holding `capacity` entries
+  explicit FrequencySketch(const std::size_t capacity)
+      : counters_(nRows * std::bit_ceil(std::max(capacity, std::size_t{1}) *
+                                        16)),
+        mask_{counters_.size() / nRows - 1},
+        sampleSize_{std::max(capacity, std::size_t{1}) * 10} {}
+
+  // Record an access
+  void increment(const std::size_t hash) noexcept {
+    for (std::size_t row{0}; row < nRows; ++row) {
+      std::uint8_t& count{counters_[index(hash, row)]};
+      count = static_cast<std::uint8_t>(std::min<int>(count + 1, maxCount));
+    }
+
+    if (++nIncrements_ == sampleSize_) {
+      for (std::uint8_t& count : counters_) {
+        count = static_cast<std::uint8_t>(count / 2);
+      }
+
+      nIncrements_ /= 2;
+    }
+  }
+
+  // Estimated number of recent accesses
+  [[nodiscard]] std::uint8_t frequency(const std::size_t hash) const noexcept {
+    std::uint8_t freq{maxCount};
+
+    for (std::size_t row{0}; row < nRows; ++row) {
+      freq = std::min(freq, counters_[index(hash, row)]);
+    }
+
+    return freq;
+  }
+};
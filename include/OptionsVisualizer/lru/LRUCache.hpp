@@ -43,6 +43,14 @@ class LRUCache {
     throw std::out_of_range{"Cannot find specified key in cache"};
   }
 
+  // Remove a value (no-op if it isn't stored)
+  void erase(const Key& key) {
+    if (const auto search{cache_.find(key)}; search != cache_.cend()) {
+      keys_.erase(search->second.iter);
+      cache_.erase(search);
+    }
+  }
+
   // Store values
   void set(const Key& key, Value&& val) {
     // We do not need to check if the value already exists in our use case
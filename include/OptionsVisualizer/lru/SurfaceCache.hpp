@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/lru/FrequencySketch.hpp"
+
+// Hit/miss counters for comparing cache policies on real traffic
+struct CacheStats {
+  std::uint64_t hits_{0};
+  std::uint64_t misses_{0};
+  std::uint64_t evictions_{0};   // resident entries pushed out
+  std::uint64_t rejections_{0};  // new entries TinyLFU declined to keep
+  std::uint64_t coldHits_{0};    // misses served by a lower tier
+
+  [[nodiscard]] double hitRate() const noexcept {
+    const std::uint64_t total{hits_ + misses_};
+    return total == 0 ? 0.0
+                      : static_cast<double>(hits_) / static_cast<double>(total);
+  }
+};
+
+// Cache of computed surfaces with a selectable admission/eviction policy.
+// With CachePolicy::LRU it behaves exactly like LRUCache. With
+// CachePolicy::TinyLFU new entries land in a small LRU window; when the window
+// overflows, its oldest entry only displaces an entry of the main area if it
+// has been requested more often (per a frequency sketch) weighted by what it
+// cost to compute. One-off or cheap surfaces therefore can't flush popular,
+// expensive ones. Entries that are evicted or rejected can be handed to an
+// eviction handler (e.g. a compressed cold tier) instead of being dropped
+template <typename Key, typename Value, typename KeyHash>
+class SurfaceCache {
+  // Oldest main-area entries considered when picking a victim
+  static constexpr std::size_t victimSamples{4};
+
+  struct Entry {
+    std::list<Key>::iterator iter;
+    Value value;
+    double cost;
+    bool inWindow;
+  };
+
+  // --- Data members
+  std::unordered_map<Key, Entry, KeyHash> cache_{};
+  std::list<Key> window_{};  // least recently used first
+  std::list<Key> main_{};    // least recently used first
+  std::size_t windowCapacity_;
+  std::size_t mainCapacity_;
+  Enums::CachePolicy policy_;
+  FrequencySketch sketch_;
+  CacheStats stats_{};
+  std::function<void(const Key&, Value&&, double)> onEvict_{};
+
+ public:
+  // Ctor (TinyLFU gives 1% of the capacity, at least one entry, to the window)
+  explicit SurfaceCache(const std::size_t capacity,
+                        const Enums::CachePolicy policy)
+      : windowCapacity_{policy == Enums::CachePolicy::LRU
+                            ? capacity
+                            : std::max(capacity / 100, std::size_t{1})},
+        mainCapacity_{capacity - std::min(windowCapacity_, capacity)},
+        policy_{policy},
+        sketch_{capacity} {
+    if (capacity < 1) {
+      throw std::invalid_argument{"Cache capacity must be at least 1"};
+    }
+
+    cache_.reserve(capacity);
+  }
+
+  // Look up a value, recording the access (nullptr on a miss)
+  [[nodiscard]] const Value* find(const Key& key) {
+    const std::size_t hash{KeyHash{}(key)};
+
+    if (policy_ == Enums::CachePolicy::TinyLFU) {
+      sketch_.increment(hash);
+    }
+
+    const auto search{cache_.find(key)};
+
+    if (search == cache_.end()) {
+      ++stats_.misses_;
+      return nullptr;
+    }
+
+    // Mark as most recently used within its area
+    ++stats_.hits_;
+    Entry& entry{search->second};
+    std::list<Key>& area{entry.inWindow ? window_ : main_};
+    area.splice(area.end(), area, entry.iter);
+    return &entry.value;
+  }
+
+  // Whether a value is resident (without recording an access)
+  [[nodiscard]] bool contains(const Key& key) const {
+    return cache_.contains(key);
+  }
+
+  // Resident value without recording an access (nullptr if it isn't resident)
+  [[nodiscard]] const Value* peek(const Key& key) const {
+    const auto search{cache_.find(key)};
+    return search == cache_.end() ? nullptr : &search->second.value;
+  }
+
+  // Store a value that cost `cost` (e.g. seconds of pricing) to compute; the
+  // value is always resident right after the call
+  const Value& set(const Key& key, Value&& val, const double cost) {
+    window_.push_back(key);
+    const auto inserted{
+        cache_
+            .emplace(key, Entry{.iter = std::prev(window_.end()),
+                                .value = std::move(val),
+                                .cost = cost,
+                                .inWindow = true})
+            .first};
+
+    if (window_.size() > windowCapacity_) {
+      admit(window_.front());
+    }
+
+    return inserted->second.value;
+  }
+
+  // Receives the key, value and cost of every entry leaving the cache
+  void setEvictionHandler(
+      std::function<void(const Key&, Value&&, double)> handler) {
+    onEvict_ = std::move(handler);
+  }
+
+  // Count a miss that a lower tier (e.g. compressed entries) could serve
+  void recordColdHit() noexcept { ++stats_.coldHits_; }
+
+  [[nodiscard]] const CacheStats& stats() const noexcept { return stats_; }
+
+  void resetStats() noexcept { stats_ = CacheStats{}; }
+
+ private:
+  // Relative worth of keeping an entry
+  [[nodiscard]] double score(const Key& key, const Entry& entry) const {
+    return static_cast<double>(sketch_.frequency(KeyHash{}(key))) * entry.cost;
+  }
+
+  // Remove an entry whose list node is handled by the caller
+  void drop(const Key& key) {
+    const auto search{cache_.find(key)};
+
+    if (onEvict_) {
+      onEvict_(key, std::move(search->second.value), search->second.cost);
+    }
+
+    cache_.erase(search);
+  }
+
+  // Move the oldest window entry into the main area or drop it (the key is
+  // copied since its list node is erased)
+  void admit(const Key candidate) {
+    Entry& entry{cache_.at(candidate)};
+    window_.erase(entry.iter);
+
+    if (main_.size() < mainCapacity_) {
+      main_.push_back(candidate);
+      entry.iter = std::prev(main_.end());
+      entry.inWindow = false;
+      return;
+    }
+
+    // LRU (no main area) simply evicts the window's oldest entry
+    if (main_.empty()) {
+      ++stats_.evictions_;
+      drop(candidate);
+      return;
+    }
+
+    // Cheapest-to-lose entry among the oldest few in the main area
+    auto victim{main_.begin()};
+    double victimScore{score(*victim, cache_.at(*victim))};
+    auto iter{std::next(victim)};
+
+    for (std::size_t n{1}; n < victimSamples && iter != main_.end();
+         ++n, ++iter) {
+      if (const double s{score(*iter, cache_.at(*iter))}; s < victimScore) {
+        victim = iter;
+        victimScore = s;
+      }
+    }
+
+    if (score(candidate, entry) <= victimScore) {
+      ++stats_.rejections_;
+      drop(candidate);
+      return;
+    }
+
+    ++stats_.evictions_;
+    drop(*victim);
+    main_.erase(victim);
+    main_.push_back(candidate);
+    entry.iter = std::prev(main_.end());
+    entry.inWindow = false;
+  }
+};
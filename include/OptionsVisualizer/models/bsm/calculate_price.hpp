@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <numbers>
+#include <unsupported/Eigen/SpecialFunctions>  // error function
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/ScratchArena.hpp"
+
+namespace models::bsm {
+
+// Read-only and writable views of a sigma x strike grid
+using ConstGridRef = Eigen::Ref<const Eigen::ArrayXXd>;
+using GridRef = Eigen::Ref<Eigen::ArrayXXd>;
+
+// Closed-form intermediate terms over a grid from log(S / K) and the drift
+// r - q + sigma^2 / 2 (taken as inputs so surfaces over the same axes can share
+// them across maturities); every output must have the grid's shape
+inline void priceTerms(const ConstGridRef& logMoneyness,
+                       const ConstGridRef& drift,
+                       const ConstGridRef& sigmasGrid, const double tau,
+                       GridRef sigmaSqrtTau, GridRef d1, GridRef cdfD1,
+                       GridRef cdfD2) {
+  // d1 = (log(S / K) + ((r - q + sigma^2 / 2) * T)) / sigma * sqrt(T)
+  sigmaSqrtTau = sigmasGrid * std::sqrt(tau);
+  d1 = (logMoneyness + (drift * tau)) / sigmaSqrtTau;
+
+  // Standard normal CDF of d1 and d2 = d1 - sigma * sqrt(T) using the error
+  // function
+  using std::numbers::sqrt2;
+  cdfD1 = 0.5 * (1.0 + (d1 / sqrt2).erf());
+  cdfD2 = 0.5 * (1.0 + ((d1 - sigmaSqrtTau) / sqrt2).erf());
+}
+
+// price = (S * e^(-qT) * N(d1)) - (K * e^(-rT) * N(d2))
+inline void callPrice(const double spot, const double r, const double q,
+                      const ConstGridRef& strikesGrid, const double tau,
+                      const ConstGridRef& cdfD1, const ConstGridRef& cdfD2,
+                      GridRef price) {
+  price = ((spot * std::exp(-q * tau)) * cdfD1) -
+          (strikesGrid * std::exp(-r * tau) * cdfD2);
+}
+
+// Closed-form Black-Scholes-Merton price of European options across a grid of
+// sigma x strike values, written to `prices` (intermediates come from the
+// calling thread's scratch arena, with puts from put-call parity)
+template <Enums::OptionType OptType>
+void calculatePrice(const double spot, const double r, const double q,
+                    const ConstGridRef& sigmasGrid,
+                    const ConstGridRef& strikesGrid, const double tau,
+                    GridRef prices) {
+  static_assert(
+      OptType == Enums::OptionType::EuroCall ||
+          OptType == Enums::OptionType::EuroPut,
+      "BSM price evaluation only expected for European options");
+
+  Utils::ScratchArena::Scope scratch{};
+  auto [logMoneyness, drift, sigmaSqrtTau, d1, cdfD1, cdfD2]{
+      scratch.arrays<6>(sigmasGrid.rows(), sigmasGrid.cols())};
+  logMoneyness = (spot / strikesGrid).log();
+  drift = (r - q) + 0.5 * sigmasGrid.square();
+  priceTerms(logMoneyness, drift, sigmasGrid, tau, sigmaSqrtTau, d1, cdfD1,
+             cdfD2);
+  callPrice(spot, r, q, strikesGrid, tau, cdfD1, cdfD2, prices);
+
+  // Put-Call Parity: P = C - S * e^(-qT) + K * e^(-rT)
+  if constexpr (OptType == Enums::OptionType::EuroPut) {
+    prices += strikesGrid * std::exp(-r * tau) - spot * std::exp(-q * tau);
+  }
+}
+
+// Allocating overload of calculatePrice
+template <Enums::OptionType OptType>
+[[nodiscard]] Eigen::ArrayXXd calculatePrice(const double spot, const double r,
+                                             const double q,
+                                             const ConstGridRef& sigmasGrid,
+                                             const ConstGridRef& strikesGrid,
+                                             const double tau) {
+  Eigen::ArrayXXd prices{sigmasGrid.rows(), sigmasGrid.cols()};
+  calculatePrice<OptType>(spot, r, q, sigmasGrid, strikesGrid, tau, prices);
+  return prices;
+}
+
+}  // namespace models::bsm
@@ -1,124 +1,169 @@
 #pragma once
 
 #include <Eigen/Dense>
-#include <array>
+#include <algorithm>
 #include <cmath>
-#include <type_traits>
+#include <stdexcept>
 #include <utility>
 
 #include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/ScratchArena.hpp"
+#include "OptionsVisualizer/models/bsm/calculate_price.hpp"
 #include "OptionsVisualizer/models/trinomial/internal/helpers.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/price_tile.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
 
 namespace models::trinomial {
 
+// Tree depths with a fully fixed-size kernel (any other depth falls back to a
+// kernel with dynamically sized node buffers)
+using SpecializedDepths = std::integer_sequence<Eigen::Index, 25, 50, 100, 200>;
+
+// Read-only and writable views of a sigma x strike grid (bind to owned arrays,
+// maps over scratch memory and blocks without copying)
+using ConstGridRef = Eigen::Ref<const Eigen::ArrayXXd>;
+using GridRef = Eigen::Ref<Eigen::ArrayXXd>;
+
+namespace internal {
+
+// Price every cell of the grid tile by tile (tiles run down the sigma rows of a
+// single strike column; the last tile of a column is padded by repeating its
+// final row and the padded results are discarded)
+template <Enums::OptionType OptType, Eigen::Index Depth, int Tile>
+void priceGrid(const double spot, const double r, const double q,
+               const ConstGridRef& sigmasGrid, const ConstGridRef& strikesGrid,
+               const double tau, const TreeSettings& settings, GridRef prices) {
+  using Column = Eigen::Array<double, Tile, 1>;
+  const Eigen::Index nRows{sigmasGrid.rows()};
+
+  for (Eigen::Index col{0}; col < sigmasGrid.cols(); ++col) {
+    for (Eigen::Index row{0}; row < nRows; row += Tile) {
+      const Eigen::Index nValid{std::min(Eigen::Index{Tile}, nRows - row)};
+      Column sigmas{};
+      Column strikes{};
+
+      for (Eigen::Index idx{0}; idx < Tile; ++idx) {
+        const Eigen::Index src{row + std::min(idx, nValid - 1)};
+        sigmas(idx) = sigmasGrid(src, col);
+        strikes(idx) = strikesGrid(src, col);
+      }
+
+      const Column tilePrices{priceTile<OptType, Depth, Tile>(
+          spot, r, q, sigmas, strikes, tau, settings)};
+
+      for (Eigen::Index idx{0}; idx < nValid; ++idx) {
+        prices(row + idx, col) = tilePrices(idx);
+      }
+    }
+  }
+}
+
+// Select the kernel matching the grid's tile height
+template <Enums::OptionType OptType, Eigen::Index Depth>
+void dispatchTile(const double spot, const double r, const double q,
+                  const ConstGridRef& sigmasGrid,
+                  const ConstGridRef& strikesGrid, const double tau,
+                  const TreeSettings& settings, GridRef prices) {
+  switch (helpers::selectTileHeight(sigmasGrid.rows())) {
+    case 8:
+      priceGrid<OptType, Depth, 8>(spot, r, q, sigmasGrid, strikesGrid, tau,
+                                   settings, prices);
+      break;
+    case 4:
+      priceGrid<OptType, Depth, 4>(spot, r, q, sigmasGrid, strikesGrid, tau,
+                                   settings, prices);
+      break;
+    case 2:
+      priceGrid<OptType, Depth, 2>(spot, r, q, sigmasGrid, strikesGrid, tau,
+                                   settings, prices);
+      break;
+    default:
+      priceGrid<OptType, Depth, 1>(spot, r, q, sigmasGrid, strikesGrid, tau,
+                                   settings, prices);
+      break;
+  }
+}
+
+// Select the kernel matching the requested depth
+template <Enums::OptionType OptType, Eigen::Index... Depths>
+void dispatchDepth(std::integer_sequence<Eigen::Index, Depths...>,
+                   const double spot, const double r, const double q,
+                   const ConstGridRef& sigmasGrid,
+                   const ConstGridRef& strikesGrid, const double tau,
+                   const TreeSettings& settings, GridRef prices) {
+  const bool specialized{
+      ((settings.depth_ == Depths &&
+        (dispatchTile<OptType, Depths>(spot, r, q, sigmasGrid, strikesGrid,
+                                       tau, settings, prices),
+         true)) ||
+       ...)};
+
+  if (!specialized) {
+    dispatchTile<OptType, Eigen::Dynamic>(spot, r, q, sigmasGrid, strikesGrid,
+                                          tau, settings, prices);
+  }
+}
+
+}  // namespace internal
+
 // Calculate price of American options across a grid of sigma x strike values
-// using trinomial pricing methodology
+// using trinomial pricing methodology (results are written to `prices` which
+// must have the same shape as the input grids). With `settings.controlVariate_`
+// the price is the lattice's early exercise premium plus the closed-form BSM
+// price of the European option
 template <Enums::OptionType OptType>
-[[nodiscard]] Eigen::ArrayXXd calculatePrice(const double spot, const double r,
-                                             const double q,
-                                             const Eigen::ArrayXXd& sigmasGrid,
-                                             const Eigen::ArrayXXd& strikesGrid,
-                                             const double tau) {
+void calculatePrice(const double spot, const double r, const double q,
+                    const ConstGridRef& sigmasGrid,
+                    const ConstGridRef& strikesGrid, const double tau,
+                    GridRef prices, const TreeSettings& settings = {}) {
   // Make sure we only use this for American option pricing
   static_assert(
       OptType == Enums::OptionType::AmerCall ||
           OptType == Enums::OptionType::AmerPut,
       "Trinomial price evaluation only expected for American options");
 
-  // --- Setup
-
-  // Discrete time steps
-  static constexpr Eigen::Index trinomialDepth{100};
-  const double dTau{tau / static_cast<double>(trinomialDepth)};
-
-  // Stock price multipliers: u = e^(sigma * sqrt(3dt)); d = 1 / u
-  const Eigen::ArrayXd u{(sigmasGrid.col(0) * std::sqrt(3.0 * dTau)).exp()};
-
-  // Single-step discount factor: discountFactor = e^(-r * dt)
-  const double discountFactor{std::exp(-r * dTau)};
-
-  // --- Intermediate risk-neutral probability terms (see Hull - Ch.20 (444))
-
-  // Drift factor scaling term: sqrt(dt / 12 * sigma^2)
-  const Eigen::ArrayXXd sigmasSq{sigmasGrid.square()};
-  const auto scalingTerm{(dTau / (12.0 * sigmasSq)).sqrt()};
-
-  // Log stock drift: r - q - sigma^2 / 2
-  const auto logStockDrift{(r - q) - (0.5 * sigmasSq)};
-
-  // Risk-neutral drift factor
-  const auto driftFactor{scalingTerm * logStockDrift};
-
-  // --- Risk-neutral probabilities
-
-  // Probability of upward price movement: p_u = sqrt(dt / 12 * sigma^2) * (r -
-  // q * sigma^2 / 2) + 1 / 6
-  const Eigen::ArrayXXd pU{driftFactor + (1.0 / 6.0)};
-
-  // Probability of downward price movement: p_d = -sqrt(dt / 12 * sigma^2) * (r
-  // - q * sigma^2 / 2) + 1 / 6 = 2 / 6 - p_u
-  const Eigen::ArrayXXd pD{(2.0 / 6.0) - pU};
-
-  // p_m = 1 - p_u - p_d
-  const Eigen::ArrayXXd pM{1.0 - pU - pD};
-
-  // --- Compute price using backward induction
-
-  // Pre-allocate buffers
-  static constexpr Eigen::Index maxNodes{2 * trinomialDepth + 1};
-  std::array nextOptionValues{
-      Utils::preallocArrays<maxNodes>(sigmasGrid.rows(), sigmasGrid.cols())};
-  std::array currOptionValues{
-      Utils::preallocArrays<maxNodes>(sigmasGrid.rows(), sigmasGrid.cols())};
-
-  // Calculate option values at expiration (shape: [node, sigma])
-  const Eigen::ArrayXXd expirationSpot{
-      helpers::buildSpotLattice(spot, u, trinomialDepth)};
+  if (settings.depth_ < 1) {
+    throw std::invalid_argument{"Trinomial depth must be at least 1"};
+  }
 
-  // Calculate payoff at expiration (intrinsic value only at expriation)
-  for (Eigen::Index node{0}; node < maxNodes; ++node) {
-    nextOptionValues[node] = helpers::intrinsicValue<OptType>(
-        strikesGrid, expirationSpot.row(node).transpose());
+  if (!std::isfinite(settings.truncation_) || settings.truncation_ < 0.0) {
+    throw std::invalid_argument{
+        "Trinomial truncation must be a non-negative number of standard "
+        "deviations"};
   }
 
-  // Backward induction
-  for (Eigen::Index depth{trinomialDepth - 1}; depth > -1; --depth) {
-    // Need depth to be signed for loop to behave properly
-    static_assert(
-        std::is_signed_v<decltype(depth)>,
-        "Expected a signed type for depth in trinomial price calculation");
-
-    // Compute spot prices at this timestep
-    const Eigen::ArrayXXd spotsDepth{helpers::buildSpotLattice(spot, u, depth)};
-    const Eigen::Index nNodes{2 * depth + 1};
-
-    // Unsigned integer for indexing arrays
-    std::size_t uNode{0};
-
-    for (Eigen::Index sNode{0}; sNode < nNodes; ++sNode, ++uNode) {
-      // Node i at current depends on nodes (i + 2, i + 1, i) (up, mid, down)
-      // from next depth (easiest to understand if you think about the simplest
-      // case where depth is 1 meaning we have three branches (0, 1, 2) and a
-      // single root at 0)
-      const Eigen::ArrayXXd& valU{nextOptionValues[uNode + 2]};
-      const Eigen::ArrayXXd& valM{nextOptionValues[uNode + 1]};
-      const Eigen::ArrayXXd& valD{nextOptionValues[uNode]};
-
-      // Calculate discounted expected value
-      const auto continuationValue{(pU * valU + pM * valM + pD * valD) *
-                                   discountFactor};
-
-      // Update optionValues: American early exercise check
-      currOptionValues[uNode] =
-          continuationValue.cwiseMax(helpers::intrinsicValue<OptType>(
-              strikesGrid, spotsDepth.row(sNode).transpose()));
+  internal::dispatchDepth<OptType>(SpecializedDepths{}, spot, r, q, sigmasGrid,
+                                   strikesGrid, tau, settings, prices);
+
+  if (settings.controlVariate_) {
+    constexpr Enums::OptionType euroType{
+        helpers::europeanCounterpart<OptType>};
+    Utils::ScratchArena::Scope scratch{};
+    Utils::ScratchArena::ArrayMap euroPrices{
+        scratch.array(prices.rows(), prices.cols())};
+    models::bsm::calculatePrice<euroType>(spot, r, q, sigmasGrid, strikesGrid,
+                                          tau, euroPrices);
+    prices += euroPrices;
+
+    // An American option is never worth less than exercising it now
+    if constexpr (OptType == Enums::OptionType::AmerCall) {
+      prices = prices.max(spot - strikesGrid);
+    } else {
+      prices = prices.max(strikesGrid - spot);
     }
-
-    // Swap buffers
-    std::swap(nextOptionValues, currOptionValues);
   }
+}
 
-  return std::move(nextOptionValues[0]);  // root node value at index 0
+// Allocating overload of calculatePrice
+template <Enums::OptionType OptType>
+[[nodiscard]] Eigen::ArrayXXd calculatePrice(
+    const double spot, const double r, const double q,
+    const ConstGridRef& sigmasGrid, const ConstGridRef& strikesGrid,
+    const double tau, const TreeSettings& settings = {}) {
+  Eigen::ArrayXXd prices{sigmasGrid.rows(), sigmasGrid.cols()};
+  calculatePrice<OptType>(spot, r, q, sigmasGrid, strikesGrid, tau, prices,
+                          settings);
+  return prices;
 }
 
 }  // namespace models::trinomial
@@ -1,38 +1,50 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <array>
+#include <cstddef>
 
 #include "OptionsVisualizer/core/Enums.hpp"
 
 namespace models::trinomial::helpers {
 
-// Construct the spot lattice for a given depth (i.e., [spot * u^{-d}, spot *
-// u^{-d+1}, ..., spot * u^{d-1}, spot * u^{d}])
-[[nodiscard]] Eigen::ArrayXXd buildSpotLattice(double spot,
-                                               const Eigen::ArrayXd& u,
-                                               Eigen::Index depth);
-
-// Compute the intrinsic value of a column vector of spot prices against a grid
-// of strike prices
-template <Enums::OptionType OptType, typename Derived>
-[[nodiscard]] Eigen::ArrayXXd intrinsicValue(
-    const Eigen::ArrayXXd& strikesGrid,
-    const Eigen::ArrayBase<Derived>& spotsCol) {
+// Tile heights (number of sigma rows priced together by a single kernel call)
+// with a fixed-size specialization, ordered from largest to smallest
+inline constexpr std::array<int, 4> tileHeights{8, 4, 2, 1};
+
+// Pick the tile height for a grid with `nRows` sigma rows (the one needing the
+// fewest vector operations per node at this CPU's SIMD width, counting padded
+// rows, and preferring taller tiles on ties)
+[[nodiscard]] int selectTileHeight(Eigen::Index nRows) noexcept;
+
+// Compute the intrinsic value of a column of spot prices against a column of
+// strike prices (returns an expression so fixed-size callers stay on the stack)
+template <Enums::OptionType OptType, typename DerivedS, typename DerivedK>
+[[nodiscard]] auto intrinsicValue(const Eigen::ArrayBase<DerivedS>& spots,
+                                  const Eigen::ArrayBase<DerivedK>& strikes) {
   // Only permit for American option pricing
   static_assert(
       OptType == Enums::OptionType::AmerCall ||
           OptType == Enums::OptionType::AmerPut,
       "Intrinsic value computation only expected for American options");
 
-  // Make sure spotsCol is a column vector
-  static_assert(Derived::ColsAtCompileTime == 1,
-                "Expected a column vector in 'intrinsicValue'");
+  // Make sure both inputs are column vectors
+  static_assert(DerivedS::ColsAtCompileTime == 1 &&
+                    DerivedK::ColsAtCompileTime == 1,
+                "Expected column vectors in 'intrinsicValue'");
 
   if constexpr (OptType == Enums::OptionType::AmerCall) {
-    return (-(strikesGrid.colwise() - spotsCol)).cwiseMax(0.0);
+    return (spots - strikes).cwiseMax(0.0);
   } else {
-    return (strikesGrid.colwise() - spotsCol).cwiseMax(0.0);
+    return (strikes - spots).cwiseMax(0.0);
   }
 }
 
+// European option with the same payoff as an American one (priced on the same
+// lattice as a control variate)
+template <Enums::OptionType OptType>
+inline constexpr Enums::OptionType europeanCounterpart{
+    OptType == Enums::OptionType::AmerCall ? Enums::OptionType::EuroCall
+                                           : Enums::OptionType::EuroPut};
+
 }  // namespace models::trinomial::helpers
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+
+namespace models::trinomial::internal {
+
+// Instruction sets with a hand-vectorized node update
+enum class SimdLevel : std::uint8_t { Generic, AVX2, AVX512 };
+
+// Widest instruction set supported by this CPU, checked once per process (the
+// OPTIONS_VISUALIZER_SIMD environment variable, set to generic, avx2 or avx512,
+// can lower it for benchmarking)
+[[nodiscard]] SimdLevel detectSimdLevel() noexcept;
+
+// Per-tile coefficients of the backward induction step
+struct NodeCoefficients {
+  const double* pU_;       // `Tile` up probabilities
+  const double* pM_;       // `Tile` middle probabilities
+  const double* pD_;       // `Tile` down probabilities
+  const double* strikes_;  // `Tile` strikes
+  double discountFactor_;
+};
+
+// Roll back lattice nodes [first, last] of one depth in place for a tile of
+// `Tile` rows. `values` and `spots` hold the rows of each node contiguously
+// (spots already offset to this depth) and each node becomes
+// max(df * (p_u * v[i + 2] + p_m * v[i + 1] + p_d * v[i]), intrinsic(S_i))
+// (European options skip the early exercise check and never read the spots).
+// Every kernel performs the same operations in the same order (no fused
+// multiply-adds) so results don't depend on the CPU
+using RollBackKernel = void (*)(const NodeCoefficients& coefficients,
+                                double* values, const double* spots,
+                                Eigen::Index first, Eigen::Index last);
+
+// Kernel for a given instruction set (falls back to narrower ones when the tile
+// is too short to fill a vector)
+template <Enums::OptionType OptType, int Tile>
+[[nodiscard]] RollBackKernel rollBackKernel(SimdLevel level) noexcept;
+
+// Kernel for this CPU
+template <Enums::OptionType OptType, int Tile>
+[[nodiscard]] RollBackKernel rollBackKernel() noexcept {
+  static const RollBackKernel kernel{
+      rollBackKernel<OptType, Tile>(detectSimdLevel())};
+  return kernel;
+}
+
+}  // namespace models::trinomial::internal
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/helpers.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/node_update.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+
+namespace models::trinomial::internal {
+
+// Number of lattice nodes at expiration for a compile-time depth (dynamic
+// depths fall back to dynamically sized buffers)
+template <Eigen::Index Depth>
+inline constexpr int maxNodesAtCompileTime{
+    Depth == Eigen::Dynamic ? Eigen::Dynamic : static_cast<int>(2 * Depth + 1)};
+
+// Price a tile of `Tile` sigma/strike pairs with a trinomial tree of
+// `settings.depth_` steps. When `Depth` is known at compile time the node
+// buffers are fixed-size and live on the stack, so the backward induction runs
+// without any heap traffic and Eigen can fully unroll/vectorize the per-node
+// update. With `settings.controlVariate_` the European option is rolled back
+// on the same lattice and the tile's early exercise premium (American minus
+// European tree price) is returned instead
+template <Enums::OptionType OptType, Eigen::Index Depth, int Tile>
+[[nodiscard]] Eigen::Array<double, Tile, 1> priceTile(
+    const double spot, const double r, const double q,
+    const Eigen::Array<double, Tile, 1>& sigmas,
+    const Eigen::Array<double, Tile, 1>& strikes, const double tau,
+    const TreeSettings& settings) {
+  using Column = Eigen::Array<double, Tile, 1>;
+  using Lattice = Eigen::Array<double, Tile, maxNodesAtCompileTime<Depth>>;
+  static constexpr bool isPut{OptType == Enums::OptionType::AmerPut};
+
+  // --- Setup
+
+  const Eigen::Index depth{settings.depth_};
+
+  // Discrete time steps
+  const double dTau{tau / static_cast<double>(depth)};
+
+  // Stock price multipliers: u = e^(sigma * sqrt(3dt)); d = 1 / u (the log is
+  // taken of u itself rather than using sigma * sqrt(3dt) directly so lattice
+  // values round identically to u^k)
+  const Column logU{(sigmas * std::sqrt(3.0 * dTau)).exp().log()};
+
+  // Single-step discount factor: discountFactor = e^(-r * dt)
+  const double discountFactor{std::exp(-r * dTau)};
+
+  // --- Intermediate risk-neutral probability terms (see Hull - Ch.20 (444))
+
+  // Drift factor scaling term: sqrt(dt / 12 * sigma^2)
+  const Column sigmasSq{sigmas.square()};
+  const auto scalingTerm{(dTau / (12.0 * sigmasSq)).sqrt()};
+
+  // Log stock drift: r - q - sigma^2 / 2
+  const auto logStockDrift{(r - q) - (0.5 * sigmasSq)};
+
+  // Risk-neutral drift factor
+  const auto driftFactor{scalingTerm * logStockDrift};
+
+  // --- Risk-neutral probabilities
+
+  // Probability of upward price movement: p_u = sqrt(dt / 12 * sigma^2) * (r -
+  // q * sigma^2 / 2) + 1 / 6
+  const Column pU{driftFactor + (1.0 / 6.0)};
+
+  // Probability of downward price movement: p_d = -sqrt(dt / 12 * sigma^2) * (r
+  // - q * sigma^2 / 2) + 1 / 6 = 2 / 6 - p_u
+  const Column pD{(2.0 / 6.0) - pU};
+
+  // p_m = 1 - p_u - p_d
+  const Column pM{1.0 - pU - pD};
+
+  // --- Compute price using backward induction
+
+  // Spot prices at expiration (column k holds spot * u^(k - depth)). The nodes
+  // at any shallower depth d are a contiguous slice of these columns starting
+  // at column (depth - d), so the lattice only has to be built once
+  const Eigen::Index maxNodes{2 * depth + 1};
+  Lattice spots{};
+  spots.resize(Tile, maxNodes);
+
+  for (Eigen::Index node{0}; node < maxNodes; ++node) {
+    spots.col(node) =
+        spot * (static_cast<double>(node - depth) * logU).exp();
+  }
+
+  // Calculate payoff at expiration (intrinsic value only at expriation)
+  Lattice optionValues{};
+  optionValues.resize(Tile, maxNodes);
+
+  for (Eigen::Index node{0}; node < maxNodes; ++node) {
+    optionValues.col(node) =
+        helpers::intrinsicValue<OptType>(spots.col(node), strikes);
+  }
+
+  // European values for the control variate (same payoff at expiration)
+  const bool controlVariate{settings.controlVariate_};
+  Lattice europeanValues{};
+
+  if (controlVariate) {
+    europeanValues = optionValues;
+  }
+
+  // Nodes further than `window` from the centre are never rolled back (their
+  // value is taken as intrinsic)
+  const Eigen::Index window{std::min(settings.window(), depth)};
+
+  // Exercise-region skip for puts: if all three children of a node are
+  // exercised, continuing is worth df * (K - S * m) with m = p_u * u + p_m +
+  // p_d / u, so exercising (K - S) stays optimal whenever
+  // (1 - df * m) * S <= K * (1 - df)
+  const bool skipExercise{isPut && settings.skipExercise_};
+  const Column exerciseSlope{
+      1.0 - discountFactor * (pU * logU.exp() + pM + pD * (-logU).exp())};
+  const Column exerciseBound{strikes * (1.0 - discountFactor)};
+
+  // Every column in [first node, exerciseEnd) of the next depth holds an
+  // exercised value (K - S > 0); at expiration that's every in-the-money node
+  Eigen::Index exerciseEnd{0};
+
+  if (skipExercise) {
+    while (exerciseEnd < maxNodes &&
+           (spots.col(exerciseEnd) < strikes).all()) {
+      ++exerciseEnd;
+    }
+  }
+
+  // Hand-vectorized node update for this CPU (see node_update.hpp)
+  const RollBackKernel rollBack{rollBackKernel<OptType, Tile>()};
+  const RollBackKernel rollBackEuropean{
+      rollBackKernel<helpers::europeanCounterpart<OptType>, Tile>()};
+  const NodeCoefficients coefficients{.pU_ = pU.data(),
+                                      .pM_ = pM.data(),
+                                      .pD_ = pD.data(),
+                                      .strikes_ = strikes.data(),
+                                      .discountFactor_ = discountFactor};
+  double* const values{optionValues.data()};
+
+  // Spot columns lined up with the nodes at depth d
+  const auto nodeSpots{[&](const Eigen::Index d) {
+    return spots.data() + (depth - d) * Tile;
+  }};
+
+  // Backward induction
+  for (Eigen::Index d{depth - 1}; d > -1; --d) {
+    // Need depth to be signed for loop to behave properly
+    static_assert(
+        std::is_signed_v<decltype(d)>,
+        "Expected a signed type for depth in trinomial price calculation");
+
+    // Nodes in the window (node i at depth d sits i - d steps from the centre)
+    const Eigen::Index reach{std::min(d, window)};
+    const Eigen::Index firstNode{d - reach};
+    const Eigen::Index lastNode{d + reach};
+    const Eigen::Index spotOffset{depth - d};
+
+    // The next depth was truncated too, so its two nodes just outside the
+    // window (read by this depth's edge nodes) take their intrinsic value
+    if (d + 1 < depth && d + 1 > window) {
+      const Eigen::Index nextOffset{spotOffset - 1};
+      optionValues.col(firstNode) = helpers::intrinsicValue<OptType>(
+          spots.col(firstNode + nextOffset), strikes);
+      optionValues.col(lastNode + 2) = helpers::intrinsicValue<OptType>(
+          spots.col(lastNode + 2 + nextOffset), strikes);
+
+      if (controlVariate) {
+        europeanValues.col(firstNode) = optionValues.col(firstNode);
+        europeanValues.col(lastNode + 2) = optionValues.col(lastNode + 2);
+      }
+
+      if (skipExercise &&
+          !(spots.col(firstNode + nextOffset) < strikes).all()) {
+        exerciseEnd = firstNode;
+      }
+    }
+
+    Eigen::Index node{firstNode};
+
+    // Exercised put nodes are settled without computing the continuation
+    if (skipExercise) {
+      while (node + 2 < exerciseEnd &&
+             (exerciseSlope * spots.col(node + spotOffset) <= exerciseBound)
+                 .all()) {
+        optionValues.col(node) = strikes - spots.col(node + spotOffset);
+        ++node;
+      }
+    }
+
+    Eigen::Index nextExerciseEnd{node};
+
+    // Nodes right after the settled ones are rolled back one at a time while
+    // they keep extending the exercised prefix
+    if (skipExercise) {
+      for (; node <= lastNode; ++node) {
+        rollBack(coefficients, values, nodeSpots(d), node, node);
+        const auto spotsAtNode{spots.col(node + spotOffset)};
+
+        if (!(spotsAtNode < strikes).all() ||
+            !(optionValues.col(node) == strikes - spotsAtNode).all()) {
+          ++node;
+          break;
+        }
+
+        ++nextExerciseEnd;
+      }
+    }
+
+    // Node i at current depends on nodes (i + 2, i + 1, i) (up, mid, down) from
+    // next depth (easiest to understand if you think about the simplest case
+    // where depth is 1 meaning we have three branches (0, 1, 2) and a single
+    // root at 0). Node i is only read again by nodes i - 1 and i - 2 which have
+    // already been updated, so the buffer is updated in place (discounted
+    // expected value, then the American early exercise check)
+    if (node <= lastNode) {
+      rollBack(coefficients, values, nodeSpots(d), node, lastNode);
+    }
+
+    exerciseEnd = nextExerciseEnd;
+
+    // The European option is never exercised, so every node is rolled back
+    if (controlVariate) {
+      rollBackEuropean(coefficients, europeanValues.data(), nodeSpots(d),
+                       firstNode, lastNode);
+    }
+  }
+
+  // Root node value at index 0
+  if (controlVariate) {
+    return optionValues.col(0) - europeanValues.col(0);
+  }
+
+  return optionValues.col(0);
+}
+
+}  // namespace models::trinomial::internal
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cmath>
+
+namespace models::trinomial {
+
+// Number of discrete time steps used by default
+inline constexpr Eigen::Index defaultDepth{100};
+
+// Lattice construction options shared by every trinomial pricing call
+struct TreeSettings {
+  // Number of discrete time steps
+  Eigen::Index depth_{defaultDepth};
+
+  // Only nodes within this many standard deviations (sigma * sqrt(tau)) of
+  // the initial spot are rolled back; nodes outside the window are replaced by
+  // their intrinsic value (0 keeps the full lattice)
+  double truncation_{0.0};
+
+  // Skip the continuation value for American put nodes whose children are all
+  // exercised and for which early exercise provably remains optimal (exact up
+  // to rounding)
+  bool skipExercise_{true};
+
+  // Also roll back the European option on the same lattice and correct the
+  // American price by the European tree's error against the closed-form BSM
+  // price (cancels most of the discretization error, so shallower trees reach
+  // the same accuracy)
+  bool controlVariate_{false};
+
+  // Strike-column blocks each surface's grid is split into when its trees are
+  // handed to the thread pool (one task per block and perturbation, so large
+  // surfaces spread over more threads, e.g. one block per NUMA node). Blocks
+  // never drop below a minimum number of cells, and the prices don't change
+  Eigen::Index partitions_{1};
+
+  // Half-width (in nodes from the centre) of the truncation window; a tree
+  // step moves sigma * sqrt(3 dt) in log-spot, so k standard deviations over
+  // tau span k * sqrt(depth / 3) nodes regardless of sigma
+  [[nodiscard]] Eigen::Index window() const noexcept {
+    if (truncation_ <= 0.0) {
+      return depth_;
+    }
+
+    const double nodes{truncation_ *
+                       std::sqrt(static_cast<double>(depth_) / 3.0)};
+    return static_cast<Eigen::Index>(std::ceil(nodes));
+  }
+};
+
+}  // namespace models::trinomial
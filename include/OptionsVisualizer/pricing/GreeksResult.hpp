@@ -10,8 +10,13 @@ struct GreeksResult {
   Eigen::ArrayXXd vega_;
   Eigen::ArrayXXd theta_;
   Eigen::ArrayXXd rho_;
+  Eigen::ArrayXXd vanna_;
+  Eigen::ArrayXXd volga_;
+  Eigen::ArrayXXd charm_;
 
   explicit GreeksResult(Eigen::ArrayXXd&& price, Eigen::ArrayXXd&& delta,
                         Eigen::ArrayXXd&& gamma, Eigen::ArrayXXd&& vega,
-                        Eigen::ArrayXXd&& theta, Eigen::ArrayXXd&& rho);
+                        Eigen::ArrayXXd&& theta, Eigen::ArrayXXd&& rho,
+                        Eigen::ArrayXXd&& vanna, Eigen::ArrayXXd&& volga,
+                        Eigen::ArrayXXd&& charm);
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+
+// Book of option positions on one underlying revalued over a spot x vol shock
+// grid: every spot shock prices one surface per maturity whose sigma axis is
+// the shocked vols and whose strike axis is the book's strikes at that
+// maturity. Only the option types held at a maturity are priced, and each is
+// reduced to quantity-weighted totals as soon as it's priced, so only the
+// per-scenario totals are ever kept
+class Portfolio {
+ public:
+  static constexpr std::size_t nGreeks{Enums::idx(Enums::GreekType::COUNT)};
+
+  // One position (the quantity is signed, negative when short)
+  struct Position {
+    Enums::OptionType optType_;
+    double strike_;
+    double tau_;
+    double quantity_;
+  };
+
+  // Book totals over the shock grid (spot shocks down the rows, vol shocks
+  // across the columns)
+  struct Scenarios {
+    // Change in book value from the unshocked market
+    Eigen::ArrayXXd pnl_;
+
+    // Quantity-weighted greeks in GreekType order (the price total is the book
+    // value)
+    std::array<Eigen::ArrayXXd, nGreeks> totals_;
+  };
+
+ private:
+  // Positions at one maturity netted per strike (strike x option type signed
+  // quantities)
+  struct Expiry {
+    double tau_;
+    Eigen::ArrayXd strikes_;
+    Eigen::ArrayXXd quantities_;
+  };
+
+  // --- Data-members
+  const std::vector<Expiry> expiries_;
+  const double spot_;
+  const double r_;
+  const double q_;
+  const double sigma_;
+  BS::priority_thread_pool& pool_;
+  const models::trinomial::TreeSettings settings_;
+
+ public:
+  explicit Portfolio(const std::vector<Position>& positions, double spot,
+                     double r, double q, double sigma,
+                     BS::priority_thread_pool& pool,
+                     const models::trinomial::TreeSettings& settings = {});
+
+  // Revalue the book with spot scaled by (1 + spot shock) and each vol shock
+  // added to sigma
+  [[nodiscard]] Scenarios revalue(const Eigen::ArrayXd& spotShocks,
+                                  const Eigen::ArrayXd& volShocks) const;
+
+ private:
+  // Net the positions by maturity and strike
+  [[nodiscard]] static std::vector<Expiry> netPositions(
+      const std::vector<Position>& positions);
+
+  // Book greek totals at one spot for each of `sigmas` (sigma x greek)
+  [[nodiscard]] Eigen::ArrayXXd totals(double spot,
+                                       const Eigen::ArrayXd& sigmas) const;
+};
@@ -4,23 +4,47 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
-// Hashable wrapper around an std::array
+// Hashable key for a pricing surface (market parameters plus the contents of
+// its sigma and strike axes)
 class PricingParams {
   friend class PricingParamsHash;
-  static constexpr std::size_t nParams{10};
-  std::array<std::int64_t, nParams> data_;
+  static constexpr std::size_t nParams{8};
 
  public:
+  using Data = std::array<std::int64_t, nParams>;
+
+ private:
+  // Grid shape, quantized market parameters and a digest of each axis
+  Data data_;
+
+  // Quantized sigma axis followed by the quantized strike axis (compared so
+  // keys that only share digests never match)
+  std::vector<std::int64_t> axes_;
+
+ public:
+  // Linearly spaced axes
   PricingParams(Eigen::Index nSigma, Eigen::Index nStrike, double spot,
                 double r, double q, double sigmaLo, double sigmaHi,
                 double strikeLo, double strikeHi, double tau);
 
+  // Explicit axes
+  PricingParams(const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+                double spot, double r, double q, double tau);
+
   bool operator==(const PricingParams& other) const noexcept;
 
+  // Quantized parameters and axis digests (used to compare keys stored outside
+  // the process)
+  [[nodiscard]] const Data& data() const noexcept { return data_; }
+
  private:
   // Scale doubles to 64-bit integers
   [[nodiscard]] static std::int64_t quantize(double param) noexcept;
+
+  // Append a quantized axis to `axes_` and return its digest
+  [[nodiscard]] std::int64_t appendAxis(const Eigen::ArrayXd& axis);
 };
 
 // Hashing "struct" for PricingParams (not marking as struct because some
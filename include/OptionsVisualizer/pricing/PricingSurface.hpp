@@ -7,15 +7,18 @@
 #include <cstdint>
 #include <future>
 #include <utility>
+#include <vector>
 
 #include "OptionsVisualizer/core/Enums.hpp"
-#include "OptionsVisualizer/core/arrayUtils.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ScratchArena.hpp"
 #include "OptionsVisualizer/core/globals.hpp"
 #include "OptionsVisualizer/models/trinomial/internal/calculate_price.hpp"
 #include "OptionsVisualizer/pricing/GreeksResult.hpp"
 
 class PricingSurface {
-  using GridArray = std::array<Eigen::ArrayXXd, globals::nGrids>;
+  using GridArray = GridBlock;
+  using ConstGridRef = models::trinomial::ConstGridRef;
 
   // --- Data-members
   const Eigen::ArrayXXd sigmasGrid_;
@@ -24,7 +27,9 @@ class PricingSurface {
   const double r_;
   const double q_;
   const double tau_;
-  BS::thread_pool<>& pool_;
+  BS::priority_thread_pool& pool_;
+  const models::trinomial::TreeSettings settings_;
+  const BS::priority_t priority_;  // of the tasks submitted to the pool
 
   // Define a simple struct to hold small perturbations for spot, sigma, and
   // tau
@@ -46,6 +51,10 @@ class PricingSurface {
     HiTau,
     LoRho,
     HiRho,
+    LoSpotLoSigma,
+    HiSpotHiSigma,
+    LoSpotLoTau,
+    HiSpotHiTau,
     COUNT
   };
 
@@ -57,18 +66,58 @@ class PricingSurface {
   explicit PricingSurface(Eigen::Index nSigma, Eigen::Index nStrike,
                           double spot, double r, double q, double sigmaLo,
                           double sigmaHi, double strikeLo, double strikeHi,
-                          double tau, BS::thread_pool<>& pool);
-
-  // Helper to append greek results together
+                          double tau, BS::priority_thread_pool& pool,
+                          const models::trinomial::TreeSettings& settings = {},
+                          BS::priority_t priority = BS::pr::normal);
+
+  // Grid over explicit (possibly non-uniform) sigma and strike axes
+  explicit PricingSurface(const Eigen::ArrayXd& sigmas,
+                          const Eigen::ArrayXd& strikes, double spot, double r,
+                          double q, double tau, BS::priority_thread_pool& pool,
+                          const models::trinomial::TreeSettings& settings = {},
+                          BS::priority_t priority = BS::pr::normal);
+
+  // Surface over individual (sigma, strike) cells instead of every combination
+  // of two axes (the grids are a single column with one row per cell)
+  [[nodiscard]] static PricingSurface overCells(
+      const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+      double spot, double r, double q, double tau,
+      BS::priority_thread_pool& pool,
+      const models::trinomial::TreeSettings& settings = {});
+
+  // Helper to copy one option type's greek results into the block
   static void appendGreeks(GridArray& grids, Enums::OptionType optType,
-                           GreeksResult&& g);
+                           const GreeksResult& g);
+
+  // BSM terms that don't depend on the maturity (the same for every surface
+  // over the same axes, spot, r and q)
+  struct BsmTerms {
+    Eigen::ArrayXXd logMoneyness_;  // log(S / K)
+    Eigen::ArrayXXd drift_;         // r - q + sigma^2 / 2
+  };
+
+  [[nodiscard]] BsmTerms bsmTerms() const;
 
   // Compute grids for all greeks and option types
   [[nodiscard]] GridArray calculateGrids() const;
 
+  // Same as above with BSM terms computed by a surface over the same axes,
+  // spot, r and q (e.g. at another maturity)
+  [[nodiscard]] GridArray calculateGrids(const BsmTerms& terms) const;
+
+  // Greeks of a single option type, pricing only what that type needs (the
+  // closed forms for European options, the type's own trees for American ones)
+  [[nodiscard]] GreeksResult greeks(Enums::OptionType optType) const;
+
  private:
+  explicit PricingSurface(Eigen::ArrayXXd sigmasGrid,
+                          Eigen::ArrayXXd strikesGrid, double spot, double r,
+                          double q, double tau, BS::priority_thread_pool& pool,
+                          const models::trinomial::TreeSettings& settings,
+                          BS::priority_t priority);
+
   // --- Black-Scholes-Merton
-  [[nodiscard]] GreeksResult bsmCallGreeks() const;
+  [[nodiscard]] GreeksResult bsmCallGreeks(const BsmTerms& terms) const;
 
   [[nodiscard]] GreeksResult bsmPutGreeks(
       const GreeksResult& callResults) const;
@@ -116,33 +165,73 @@ class PricingSurface {
         // Risk-free rate perturbations for rho
         {PerturbKind::LoRho, Perturb{.dR_ = -dR}},
         {PerturbKind::HiRho, Perturb{.dR_ = dR}},
+
+        // Joint spot and sigma perturbations for vanna
+        {PerturbKind::LoSpotLoSigma,
+         Perturb{.dSpot_ = -dSpot, .sigmaMult_ = 1.0 - sigmaShift}},
+        {PerturbKind::HiSpotHiSigma,
+         Perturb{.dSpot_ = dSpot, .sigmaMult_ = 1.0 + sigmaShift}},
+
+        // Joint spot and tau perturbations for charm
+        {PerturbKind::LoSpotLoTau, Perturb{.dSpot_ = -dSpot, .dTau_ = -dTau}},
+        {PerturbKind::HiSpotHiTau, Perturb{.dSpot_ = dSpot, .dTau_ = dTau}},
     }};
 
-    // Prepare an array to hold futures for asynchronous price calculations
-    std::array<std::future<Eigen::ArrayXXd>, nPerturbs> futures{};
+    // Perturbed prices are only needed to build the finite differences, so
+    // they live in this thread's scratch arena (the pricing tasks write
+    // straight into them and the memory is released in bulk once the greeks
+    // have been computed)
+    Utils::ScratchArena::Scope scratch{};
+    std::array prices{
+        scratch.arrays<nPerturbs>(sigmasGrid_.rows(), sigmasGrid_.cols())};
+
+    // Prepare a vector to hold futures for asynchronous price calculations
+    // (one per perturbation and block of strike columns)
+    const Eigen::Index nCols{sigmasGrid_.cols()};
+    const Eigen::Index nBlocks{partitions()};
+    std::vector<std::future<void>> futures{};
+    futures.reserve(nPerturbs * static_cast<std::size_t>(nBlocks));
 
     // Launch asynchronous tasks for each perturbation using the thread pool
     for (std::size_t idx{0}; idx < nPerturbs; ++idx) {
       const auto& [_, p]{perturbs[idx]};
-
-      futures[idx] = pool_.submit_task([p, this] {
-        // Compute the option price with the specified perturbation applied
-        return models::trinomial::calculatePrice<OptType>(
-            this->spot_ + p.dSpot_,  // perturbed spot
-            this->r_ + p.dR_,        // perturbed risk-free rate
-            this->q_,
-            this->sigmasGrid_ * p.sigmaMult_,  // perturbed sigmas
-            this->strikesGrid_,
-            this->tau_ + p.dTau_);  // perturbed time to maturity
-      });
+      Utils::ScratchArena::ArrayMap& out{prices[idx]};
+
+      for (Eigen::Index block{0}; block < nBlocks; ++block) {
+        // Block widths differ by at most one column
+        const Eigen::Index col{block * nCols / nBlocks};
+        const Eigen::Index width{(block + 1) * nCols / nBlocks - col};
+
+        futures.push_back(pool_.submit_task(
+            [p, &out, col, width, this] {
+              // Perturbed sigmas come from the pool thread's own arena
+              Utils::ScratchArena::Scope taskScratch{};
+              Utils::ScratchArena::ArrayMap sigmas{
+                  taskScratch.array(sigmasGrid_.rows(), width)};
+              sigmas = this->sigmasGrid_.middleCols(col, width) *
+                       p.sigmaMult_;  // perturbed sigmas
+
+              // Compute the option price with the specified perturbation
+              // applied
+              models::trinomial::calculatePrice<OptType>(
+                  this->spot_ + p.dSpot_,  // perturbed spot
+                  this->r_ + p.dR_,        // perturbed risk-free rate
+                  this->q_, sigmas, this->strikesGrid_.middleCols(col, width),
+                  this->tau_ + p.dTau_,  // perturbed time to maturity
+                  out.middleCols(col, width), this->settings_);
+            },
+            priority_));
+      }
     }
 
-    // Retrieve the computed prices from the futures
-    std::array prices{Utils::preallocArrays<nPerturbs>(sigmasGrid_.rows(),
-                                                       sigmasGrid_.cols())};
+    // Wait for every task before surfacing any failure since the tasks write
+    // into scratch memory owned by this scope
+    for (auto& future : futures) {
+      future.wait();
+    }
 
-    for (std::size_t idx{0}; idx < nPerturbs; ++idx) {
-      prices[idx] = futures[idx].get();
+    for (auto& future : futures) {
+      future.get();
     }
 
     const auto& base{prices[idx(PerturbKind::Base)]};
@@ -154,6 +243,10 @@ class PricingSurface {
     const auto& hiTau{prices[idx(PerturbKind::HiTau)]};
     const auto& loRho{prices[idx(PerturbKind::LoRho)]};
     const auto& hiRho{prices[idx(PerturbKind::HiRho)]};
+    const auto& loSpotLoSigma{prices[idx(PerturbKind::LoSpotLoSigma)]};
+    const auto& hiSpotHiSigma{prices[idx(PerturbKind::HiSpotHiSigma)]};
+    const auto& loSpotLoTau{prices[idx(PerturbKind::LoSpotLoTau)]};
+    const auto& hiSpotHiTau{prices[idx(PerturbKind::HiSpotHiTau)]};
 
     // --- First-order derivatives (delta, vega, theta, rho)
 
@@ -170,34 +263,63 @@ class PricingSurface {
     // Compute rho (first derivative w.r.t r)
     Eigen::ArrayXXd rho{firstOrderCdm(loRho, hiRho, dR)};
 
-    // --- Second-order derivatives (gamma)
+    // --- Second-order derivatives (gamma, vanna, volga, charm)
 
     // Compute gamma (second derivative w.r.t spot)
     Eigen::ArrayXXd gamma{secondOrderCdm(loSpot, base, hiSpot, dSpot)};
 
-    return GreeksResult{std::move(prices[idx(PerturbKind::Base)]),
+    // Compute vanna (cross derivative w.r.t spot and sigma)
+    Eigen::ArrayXXd vanna{crossCdm(loSpot, hiSpot, loSigma, hiSigma, base,
+                                   loSpotLoSigma, hiSpotHiSigma, dSpot,
+                                   dSigma)};
+
+    // Compute volga (second derivative w.r.t sigma)
+    Eigen::ArrayXXd volga{secondOrderCdm(loSigma, base, hiSigma, dSigma)};
+
+    // Compute charm (negative cross derivative w.r.t spot and tau)
+    Eigen::ArrayXXd charm{-crossCdm(loSpot, hiSpot, loTau, hiTau, base,
+                                    loSpotLoTau, hiSpotHiTau, dSpot, dTau)};
+
+    return GreeksResult{Eigen::ArrayXXd{base},
                         std::move(delta),
                         std::move(gamma),
                         std::move(vega),
                         std::move(theta),
-                        std::move(rho)};
+                        std::move(rho),
+                        std::move(vanna),
+                        std::move(volga),
+                        std::move(charm)};
   }
 
+  // Strike-column blocks the trees of one perturbation are split into
+  [[nodiscard]] Eigen::Index partitions() const noexcept;
+
   // --- Helpers to compute first and second order derivatives using central
   // difference method (templated to handle array or scalar epsilons)
 
   template <typename T>
-  static Eigen::ArrayXXd firstOrderCdm(const Eigen::ArrayXXd& lo,
-                                       const Eigen::ArrayXXd& hi,
-                                       const T& eps) {
+  static Eigen::ArrayXXd firstOrderCdm(const ConstGridRef& lo,
+                                       const ConstGridRef& hi, const T& eps) {
     return (hi - lo) / (2.0 * eps);
   }
 
   template <typename T>
-  static Eigen::ArrayXXd secondOrderCdm(const Eigen::ArrayXXd& lo,
-                                        const Eigen::ArrayXXd& base,
-                                        const Eigen::ArrayXXd& hi,
-                                        const T& eps) {
+  static Eigen::ArrayXXd secondOrderCdm(const ConstGridRef& lo,
+                                        const ConstGridRef& base,
+                                        const ConstGridRef& hi, const T& eps) {
     return (hi - (2.0 * base) + lo) / (eps * eps);
   }
+
+  // Mixed derivative w.r.t x and y from the one-sided neighbors of each, the
+  // base and the two points where both are shifted the same way (two trees
+  // fewer than the four-corner stencil for the same second-order accuracy)
+  template <typename T, typename U>
+  static Eigen::ArrayXXd crossCdm(
+      const ConstGridRef& loX, const ConstGridRef& hiX, const ConstGridRef& loY,
+      const ConstGridRef& hiY, const ConstGridRef& base,
+      const ConstGridRef& loXloY, const ConstGridRef& hiXhiY, const T& epsX,
+      const U& epsY) {
+    return (hiXhiY - hiX - hiY + (2.0 * base) - loX - loY + loXloY) /
+           (2.0 * epsX * epsY);
+  }
 };
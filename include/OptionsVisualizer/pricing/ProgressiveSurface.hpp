@@ -0,0 +1,91 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+
+// Coarse-to-fine pricing of one surface: a preview over every `stride`-th
+// sigma row and strike column on a shallow tree (interpolated back onto the
+// full axes), then every cell on the shallow tree, then the final surface. Each
+// stage replaces the published grids so readers can poll while the next one is
+// being computed. The intermediate stages are handed to the pool ahead of final
+// stages, and a surface that has been superseded (e.g. by a newer slider
+// position) stops before its next stage
+class ProgressiveSurface {
+ public:
+  using GridArray = GridBlock;
+
+  // Refinement stages (the stage number doubles as the surface's version;
+  // stages that wouldn't improve on the previous one are skipped)
+  enum class Stage : std::uint8_t { Pending, Preview, Shallow, Final };
+
+  // Latest published stage (`grids_` is null while pending)
+  struct Snapshot {
+    Stage stage_{Stage::Pending};
+    std::shared_ptr<const GridArray> grids_{};
+  };
+
+ private:
+  // --- Data-members
+  const Eigen::ArrayXd sigmas_;
+  const Eigen::ArrayXd strikes_;
+  const double spot_;
+  const double r_;
+  const double q_;
+  const double tau_;
+  BS::priority_thread_pool& pool_;
+  const models::trinomial::TreeSettings settings_;
+  const Eigen::Index stride_;
+  const Eigen::Index previewDepth_;
+
+  std::atomic<bool> superseded_;
+
+  mutable std::mutex mutex_;
+  Snapshot latest_;
+  double stageSeconds_;  // pricing wall time of the latest stage
+
+ public:
+  explicit ProgressiveSurface(Eigen::ArrayXd sigmas, Eigen::ArrayXd strikes,
+                              double spot, double r, double q, double tau,
+                              BS::priority_thread_pool& pool,
+                              const models::trinomial::TreeSettings& settings,
+                              Eigen::Index stride, Eigen::Index previewDepth);
+
+  // Compute every stage in order, publishing each one as it completes (run on
+  // a thread outside `pool`, which prices the cells); returns early without a
+  // final stage if the surface is superseded
+  void run();
+
+  // Skip the stages that haven't started yet (the one being priced still
+  // publishes)
+  void supersede() noexcept;
+
+  // Undo `supersede` (has no effect once `run` has returned)
+  void resume() noexcept;
+
+  [[nodiscard]] Snapshot latest() const;
+
+  // Pricing wall time of the latest published stage
+  [[nodiscard]] double stageSeconds() const;
+
+ private:
+  void publish(Stage stage, GridArray&& grids, double seconds);
+
+  // Every `stride`-th point of an axis (always keeping the last one)
+  [[nodiscard]] static Eigen::ArrayXd subsample(const Eigen::ArrayXd& axis,
+                                                Eigen::Index stride);
+
+  // Bilinear interpolation of a grid over (coarse sigmas x coarse strikes) onto
+  // (sigmas x strikes)
+  [[nodiscard]] static Eigen::ArrayXXd interpolate(
+      const GridBlock::ConstGrid& coarse, const Eigen::ArrayXd& coarseSigmas,
+      const Eigen::ArrayXd& coarseStrikes, const Eigen::ArrayXd& sigmas,
+      const Eigen::ArrayXd& strikes);
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+// Surfaces that share spot, r, q and tau (e.g. several sessions looking at
+// different sigma/strike ranges or resolutions of the same underlying) priced
+// together: every unique (sigma, strike) cell across them is priced once in a
+// single pass and the results are scattered back into each surface's grids
+class SurfaceBatch : public std::enable_shared_from_this<SurfaceBatch> {
+ public:
+  using GridArray = GridBlock;
+
+  // Sigma and strike axes of one surface in the batch
+  struct Axes {
+    Eigen::ArrayXd sigmas_;
+    Eigen::ArrayXd strikes_;
+  };
+
+ private:
+  // --- Data-members
+  const double spot_;
+  const double r_;
+  const double q_;
+  const double tau_;
+  const std::chrono::duration<double> window_;
+  BS::priority_thread_pool& pool_;
+  const models::trinomial::TreeSettings settings_;
+
+  // Surfaces that joined before the batch closed (and the tasks reporting
+  // their results)
+  mutable std::mutex mutex_;
+  bool closed_;
+  std::vector<Axes> members_;
+  std::vector<std::shared_ptr<SurfaceTask>> tasks_;
+
+ public:
+  // Batch that accepts surfaces for `window` after the first one joins and
+  // then prices them all on a new (detached) thread; `pool` only has to
+  // outlive the pricing, so wait on the member tasks before destroying it
+  // (must be owned by a shared_ptr)
+  explicit SurfaceBatch(double spot, double r, double q, double tau,
+                        std::chrono::duration<double> window,
+                        BS::priority_thread_pool& pool,
+                        const models::trinomial::TreeSettings& settings);
+
+  SurfaceBatch(const SurfaceBatch&) = delete;
+  SurfaceBatch& operator=(const SurfaceBatch&) = delete;
+
+  // Price several surfaces at once (one set of grids per member, in order)
+  [[nodiscard]] static std::vector<GridArray> price(
+      const std::vector<Axes>& members, double spot, double r, double q,
+      double tau, BS::priority_thread_pool& pool,
+      const models::trinomial::TreeSettings& settings);
+
+  // Whether surfaces with these parameters can join the batch
+  [[nodiscard]] bool matches(double spot, double r, double q,
+                             double tau) const noexcept;
+
+  // Add a surface to the batch (null once the batch has stopped accepting
+  // surfaces, which never happens before the first one joined)
+  [[nodiscard]] std::shared_ptr<SurfaceTask> join(Eigen::ArrayXd sigmas,
+                                                  Eigen::ArrayXd strikes);
+
+  [[nodiscard]] bool closed() const;
+
+ private:
+  // Stop accepting surfaces, price them and finish their tasks
+  void run();
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+// Surfaces submitted for background pricing, priced in arrival order by at most
+// `maxThreads` orchestrating threads (pricing waits on the cells it hands to
+// the pool, so it can't be a pool task itself): like `orchestrate`, that's
+// enough to keep a pool of that size busy, however many surfaces are queued.
+// Threads are started as the queue needs them and live until it's destroyed
+class SurfaceQueue {
+  // --- Data-members
+  std::mutex mutex_;
+  std::condition_variable pending_;
+  std::deque<std::pair<SurfaceSpec, std::shared_ptr<SurfaceTask>>> queue_;
+  std::size_t idle_;  // threads waiting for a surface
+  bool stopping_;
+
+  BS::priority_thread_pool& pool_;
+  models::trinomial::TreeSettings settings_;
+  std::size_t maxThreads_;
+  std::vector<std::jthread> threads_;
+
+ public:
+  // `pool` has to outlive the queue
+  SurfaceQueue(BS::priority_thread_pool& pool,
+               const models::trinomial::TreeSettings& settings,
+               std::size_t maxThreads);
+
+  SurfaceQueue(const SurfaceQueue&) = delete;
+  SurfaceQueue& operator=(const SurfaceQueue&) = delete;
+
+  // Prices the surfaces still queued before joining the threads
+  ~SurfaceQueue();
+
+  // Queue a surface and return its (unfinished) task
+  [[nodiscard]] std::shared_ptr<SurfaceTask> push(SurfaceSpec surface);
+
+ private:
+  // Price queued surfaces until the queue is stopped and empty
+  void work();
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Eigen/Dense>
+
+// Inputs of one pricing surface (market parameters and its sigma and strike
+// axes)
+struct SurfaceSpec {
+  Eigen::ArrayXd sigmas_;
+  Eigen::ArrayXd strikes_;
+  double spot_;
+  double r_;
+  double q_;
+  double tau_;
+};
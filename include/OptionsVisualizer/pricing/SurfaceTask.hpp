@@ -0,0 +1,91 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+
+// One surface priced in the background: an orchestrating thread (see
+// SurfaceQueue) prices it (it waits on the cells it hands to the pool, so it
+// can't be a pool task itself) while any number of threads can wait on the
+// result or register callbacks for when it's ready
+class SurfaceTask {
+  // Batches finish the tasks of the surfaces they price together
+  friend class SurfaceBatch;
+
+ public:
+  using GridArray = GridBlock;
+
+  // Completion callbacks run on the pricing thread (or on the registering
+  // thread if the task is already finished) and must not throw
+  using Callback = std::function<void(const SurfaceTask&)>;
+
+ private:
+  // --- Data-members
+  mutable std::mutex mutex_;
+  mutable std::condition_variable finished_;
+  bool started_;  // pricing (or cancelling) has begun
+  bool done_;
+  std::shared_ptr<const GridArray> grids_;
+  std::exception_ptr error_;
+  double seconds_;  // pricing wall time
+  std::vector<Callback> callbacks_;
+
+ public:
+  // Unfinished task (see `price`)
+  SurfaceTask();
+
+  // Task that is finished from the start (e.g. with cached grids)
+  explicit SurfaceTask(GridArray grids);
+
+  SurfaceTask(const SurfaceTask&) = delete;
+  SurfaceTask& operator=(const SurfaceTask&) = delete;
+
+  // Price several surfaces one after the other on a single new (detached)
+  // thread, submitting their work to the pool at `priority` (e.g. a background
+  // warm-up that interactive requests overtake). Surfaces that haven't started
+  // once `cancelled` is set fail instead of being priced (as do individually
+  // cancelled ones)
+  [[nodiscard]] static std::vector<std::shared_ptr<SurfaceTask>> startSequence(
+      std::vector<SurfaceSpec> surfaces, BS::priority_thread_pool& pool,
+      const models::trinomial::TreeSettings& settings, BS::priority_t priority,
+      std::shared_ptr<const std::atomic<bool>> cancelled);
+
+  // Run `callback` once the task is finished
+  void onDone(Callback callback);
+
+  [[nodiscard]] bool done() const;
+
+  void wait() const;
+
+  // Priced grids (waits for them and rethrows a pricing failure)
+  [[nodiscard]] std::shared_ptr<const GridArray> grids() const;
+
+  // Pricing wall time (0 for tasks that were finished from the start)
+  [[nodiscard]] double seconds() const;
+
+  // Finish a task whose pricing hasn't started with a "Pricing cancelled"
+  // failure (false if it has started or finished, in which case it's left
+  // alone)
+  bool cancel();
+
+  // Price a surface on the calling thread and finish the (unfinished) task with
+  // the result or the failure, so other threads can wait on it in the meantime
+  // (does nothing if the task was cancelled)
+  void price(const SurfaceSpec& surface, BS::priority_thread_pool& pool,
+             const models::trinomial::TreeSettings& settings,
+             BS::priority_t priority);
+
+ private:
+  void finish(std::shared_ptr<const GridArray> grids, std::exception_ptr error,
+              double seconds);
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+
+// Surfaces at several maturities over the same sigma and strike axes, spot, r
+// and q (a tau x sigma x strike cube per greek and option type) priced in one
+// go: the BSM terms that don't depend on the maturity are computed once, and
+// every maturity's trees are handed to the pool together rather than one
+// maturity after the other
+class TermStructure {
+ public:
+  using GridArray = GridBlock;
+
+ private:
+  // --- Data-members
+  const Eigen::ArrayXd sigmas_;
+  const Eigen::ArrayXd strikes_;
+  const double spot_;
+  const double r_;
+  const double q_;
+  const Eigen::ArrayXd taus_;
+  BS::priority_thread_pool& pool_;
+  const models::trinomial::TreeSettings settings_;
+
+ public:
+  explicit TermStructure(const Eigen::ArrayXd& sigmas,
+                         const Eigen::ArrayXd& strikes, double spot, double r,
+                         double q, const Eigen::ArrayXd& taus,
+                         BS::priority_thread_pool& pool,
+                         const models::trinomial::TreeSettings& settings = {});
+
+  // Compute grids for all greeks and option types (one block per maturity, in
+  // the order of `taus`)
+  [[nodiscard]] std::vector<GridArray> calculateGrids() const;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Run `job(idx)` for every idx in [0, nJobs) and return the results in index
+// order. Jobs that submit work to the thread pool and wait on it can't be pool
+// tasks themselves, so they're pulled off a shared counter by at most
+// `maxThreads` orchestrating threads (the calling thread is one of them):
+// that's enough to keep a pool of `maxThreads` busy without spawning a thread
+// per job. Every job runs before the first failure (in index order) is
+// rethrown, since jobs usually share the caller's state
+template <typename Job>
+[[nodiscard]] std::vector<std::invoke_result_t<Job&, std::size_t>> orchestrate(
+    const std::size_t nJobs, const std::size_t maxThreads, Job&& job) {
+  using Result = std::invoke_result_t<Job&, std::size_t>;
+
+  std::vector<std::optional<Result>> results(nJobs);
+  std::vector<std::exception_ptr> errors(nJobs);
+  std::atomic<std::size_t> next{0};
+
+  const auto worker{[&] {
+    for (std::size_t idx{next++}; idx < nJobs; idx = next++) {
+      try {
+        results[idx].emplace(std::invoke(job, idx));
+      } catch (...) {
+        errors[idx] = std::current_exception();
+      }
+    }
+  }};
+
+  {
+    const std::size_t nThreads{
+        std::min(nJobs, std::max(maxThreads, std::size_t{1}))};
+    std::vector<std::jthread> threads{};
+    threads.reserve(nThreads > 0 ? nThreads - 1 : 0);
+
+    for (std::size_t idx{1}; idx < nThreads; ++idx) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+  }  // join the other orchestrators
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::vector<Result> out{};
+  out.reserve(nJobs);
+
+  for (std::optional<Result>& result : results) {
+    out.push_back(std::move(*result));
+  }
+
+  return out;
+}
@@ -2,6 +2,7 @@ import dash
 import dash_bootstrap_components as dbc
 from callbacks import register_callbacks
 from config import SETTINGS
+from dash import dcc
 from dash_bootstrap_templates import load_figure_template
 from panels import create_control_panel, create_heatmap_grid
 
@@ -17,7 +18,9 @@ def create_layout() -> dbc.Container:
                     dbc.Col(create_control_panel(), md=3, className="h-100"),
                     dbc.Col(create_heatmap_grid(), md=9, className="h-100"),
                 ],
-            )
+            ),
+            # Polls surfaces that are still being refined (see ENGINE_PROGRESSIVE)
+            dcc.Interval(id="refine_interval", interval=SETTINGS.REFINE_INTERVAL_MS, disabled=True),
         ],
     )
 
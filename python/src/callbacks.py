@@ -6,6 +6,7 @@ from dash.exceptions import PreventUpdate
 from mappings import GREEK_ENUM, OPTION_TYPES
 from plotly.graph_objects import Figure
 from plotting import generate_heatmap_figure
+from typing import Optional
 from services import PricingService
 from slider import compute_strike_slider, StrikeSliderConfig
 from validate import all_valid, is_valid_value
@@ -50,11 +51,14 @@ def register_callbacks(app: dash.Dash) -> None:
 
         return html.Pre(f"S = ${spot:,.2f}\nT = {tau:.2f} years\nr = {r:.2%}\nq = {q:.2%}")
 
-    # --- Update heatmap plots
+    # --- Update heatmap plots (the refine interval re-polls surfaces that are still being refined in progressive
+    # mode and is disabled again once they're final)
     @app.callback(
-        [Output(f"heatmap_{option.id}", "figure") for option in OPTION_TYPES.values()],
+        [Output(f"heatmap_{option.id}", "figure") for option in OPTION_TYPES.values()]
+        + [Output("refine_interval", "disabled")],
         [Input(f"{param}_range", "value") for param in ["sigma", "strike"]],
         [Input(param, "value") for param in ["greek_selector", "input_spot", "input_tau", "input_r", "input_q"]],
+        Input("refine_interval", "n_intervals"),
     )
     def update_heatmaps(
             sigma_range: list[float],
@@ -64,24 +68,41 @@ def register_callbacks(app: dash.Dash) -> None:
             tau: float,
             r: float,
             q: float,
-    ) -> tuple[Figure, ...]:
+            _n_intervals: int,
+    ) -> tuple:
         if not all_valid(sigma_range=sigma_range, strike_range=strike_range, spot=spot, tau=tau, r=r, q=q):
             raise PreventUpdate
 
+        # Record user interactions for load replays (not the polls of a surface that is being refined)
+        if dash.ctx.triggered_id != "refine_interval":
+            PricingService.record_request(spot, r, q, sigma_range, strike_range, tau)
+
         try:
             greek_idx: int = int(greek_selector)
-            grids: tuple[np.ndarray, ...]
+            grids: Optional[tuple[np.ndarray, ...]]
             strikes: np.ndarray
             sigmas: np.ndarray
+            final: bool
+            color_range: Optional[tuple[float, float]]
 
             # C++ engine call returns a grid for each option type (American and Europena put and call)
-            grids, strikes, sigmas = PricingService.calculate_greeks(
+            grids, strikes, sigmas, final, color_range = PricingService.calculate_greeks(
                 greek_idx, spot, r, q, sigma_range, strike_range, tau
             )
 
-            # Calculate global color scale across all 4 heatmaps
-            z_min: np.float64 = min(grid.min() for grid in grids)
-            z_max: np.float64 = max(grid.max() for grid in grids)
+            # Keep the current figures until the first preview is ready
+            if grids is None:
+                return (dash.no_update,) * len(OPTION_TYPES) + (False,)
+
+            # Global color scale across all 4 heatmaps (computed by the engine unless the grids are a progressive
+            # preview or come from the daemon)
+            z_min: float
+            z_max: float
+            if color_range is None:
+                z_min = min(grid.min() for grid in grids)
+                z_max = max(grid.max() for grid in grids)
+            else:
+                z_min, z_max = color_range
 
             return tuple(
                 generate_heatmap_figure(
@@ -93,7 +114,7 @@ def register_callbacks(app: dash.Dash) -> None:
                     color_range=(z_min, z_max),
                 )
                 for i, opt_idx in enumerate(OPTION_TYPES.keys())
-            )
+            ) + (final,)
 
         except Exception:
             # Fallback to empty zero-grids if engine fails
@@ -106,4 +127,4 @@ def register_callbacks(app: dash.Dash) -> None:
                     greek_idx=int(GREEK_ENUM.Price.value),
                 )
                 for idx in OPTION_TYPES.keys()
-            )
+            ) + (True,)
@@ -1,5 +1,5 @@
 from pydantic import BaseModel, ConfigDict
-from typing import Optional
+from typing import Literal, Optional
 
 
 class Settings(BaseModel):
@@ -9,6 +9,28 @@ class Settings(BaseModel):
     DEBUG: bool = False
     ENGINE_CAPACITY: int = 16
     ENGINE_THREADS: Optional[int] = None
+    ENGINE_AFFINITY: str = "Off"  # "Off", "Core" or "Node": pin pricing threads to cores or NUMA nodes
+    ENGINE_PARTITIONS: int = 1  # split large surfaces into this many blocks of strike columns (0: one per NUMA node)
+    ENGINE_CACHE_POLICY: str = "LRU"  # "LRU" or "TinyLFU" (cost-aware admission and eviction)
+    ENGINE_COLD_CAPACITY: int = 64  # evicted surfaces kept compressed (0 disables the cold tier)
+    ENGINE_COLD_TOLERANCE: float = 1e-4  # max error relative to each grid's largest magnitude
+    ENGINE_TREE_DEPTH: int = 100  # time steps of the American pricing trees
+    ENGINE_TRUNCATION: float = 0.0  # prune tree nodes beyond this many standard deviations (0 keeps the full lattice)
+    ENGINE_CONTROL_VARIATE: bool = False  # correct American trees by the European tree's error against BSM
+    ENGINE_SIGMA_SPACING: str = "Linear"  # "Linear", "Log" or "Chebyshev" heatmap rows
+    ENGINE_STRIKE_SPACING: str = "Linear"  # "Linear", "Log" or "Chebyshev" heatmap columns
+    ENGINE_HEATMAP_ENCODING: Literal["Float64", "Float32"] = "Float32"  # precision of the values sent to the heatmaps
+    ENGINE_PROGRESSIVE: bool = False  # show a coarse preview first and refine it in the background
+    ENGINE_PREVIEW_STRIDE: int = 4  # preview prices every n-th sigma row and strike column
+    ENGINE_PREVIEW_DEPTH: int = 25  # tree depth of the preview and intermediate stages
+    ENGINE_COALESCE_MS: float = 0.0  # batch submissions sharing spot/r/q/tau within this window (0 disables)
+    ENGINE_WARMUP: bool = True  # price the default view in the background at startup
+    ENGINE_WARMUP_STEPS: int = 0  # also warm views this many input steps either side of the default spot, tau, r and q
+    REFINE_INTERVAL_MS: int = 250  # how often the heatmaps poll a surface that is still being refined
+    ENGINE_SOCKET: Optional[str] = None  # pricing daemon socket (computes in-process when unset)
+    ENGINE_SHARED_CACHE: Optional[str] = None  # host-wide shared-memory cache name, e.g. "/options_visualizer"
+    ENGINE_SHARED_CAPACITY: int = 64
+    ENGINE_TRACE_FILE: Optional[str] = None  # append every heatmap request here (replayed by PricingEngineReplay)
     PLOT_THEME: str = "darkly"
 
     # --- Core app parameters
@@ -0,0 +1,184 @@
+import enum
+import mmap
+import numpy as np
+import os
+import socket
+import struct
+import threading
+from collections import OrderedDict
+
+# Wire format shared with the C++ pricing daemon (see include/OptionsVisualizer/ipc/DaemonProtocol.hpp and
+# SharedGrids.hpp); both ends run on the same host so structs use native byte order without padding
+_PROTOCOL_MAGIC: int = 0x4F565044  # "OVPD"
+_PROTOCOL_VERSION: int = 1
+_REQUEST: struct.Struct = struct.Struct("=IIqq8d")
+_RESPONSE: struct.Struct = struct.Struct("=Ii64s192s")
+_SEGMENT_MAGIC: int = 0x4F565347  # "OVSG"
+_SEGMENT_HEADER: struct.Struct = struct.Struct("=IIqqQQQ")
+_STATUS_OK: int = 0
+_SHM_DIR: str = "/dev/shm"
+
+
+class DaemonError(RuntimeError):
+    pass
+
+
+class DaemonClient:
+    # Drop-in replacement for OptionsManager.get_greek that forwards requests to the host-wide pricing daemon and
+    # maps the results straight out of shared memory (read-only, no copies or deserialization)
+
+    def __init__(self, socket_path: str, max_mapped: int = 16) -> None:
+        self._socket_path: str = socket_path
+        self._sock: socket.socket | None = None
+        self._lock: threading.Lock = threading.Lock()
+        self._max_mapped: int = max_mapped
+        self._mapped: OrderedDict[str, mmap.mmap] = OrderedDict()
+
+    def get_greek(
+        self,
+        greek_type: enum.Enum,
+        n_sigma: int,
+        n_strike: int,
+        spot: float,
+        r: float,
+        q: float,
+        sigma_lo: float,
+        sigma_hi: float,
+        strike_lo: float,
+        strike_hi: float,
+        tau: float,
+        sigma_spacing: enum.Enum | None = None,
+        strike_spacing: enum.Enum | None = None,
+    ) -> tuple[np.ndarray, ...]:
+        # The wire format only carries axis bounds, so the daemon always prices linearly spaced axes
+        for spacing in (sigma_spacing, strike_spacing):
+            if spacing is not None and spacing.name != "Linear":
+                raise DaemonError(f"Pricing daemon only supports linear axes (got {spacing.name})")
+
+        request: bytes = _REQUEST.pack(
+            _PROTOCOL_MAGIC,
+            _PROTOCOL_VERSION,
+            n_sigma,
+            n_strike,
+            spot,
+            r,
+            q,
+            sigma_lo,
+            sigma_hi,
+            strike_lo,
+            strike_hi,
+            tau,
+        )
+
+        with self._lock:
+            # The daemon may unlink a segment (cache eviction) between replying and us mapping it, in which case
+            # asking again republishes the results
+            for attempt in range(2):
+                segment: str = self._request(request)
+
+                try:
+                    buf: mmap.mmap = self._map(segment)
+                    break
+                except FileNotFoundError:
+                    if attempt == 1:
+                        raise
+
+        return self._views(buf, int(greek_type.value))
+
+    def _request(self, request: bytes) -> str:
+        # Reconnect once if the daemon was restarted since the last request
+        for attempt in range(2):
+            try:
+                if self._sock is None:
+                    self._sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+                    self._sock.connect(self._socket_path)
+
+                self._sock.sendall(request)
+                response: bytes = self._recv_exact(_RESPONSE.size)
+                break
+            except OSError:
+                self._close()
+
+                if attempt == 1:
+                    raise
+
+        magic: int
+        status: int
+        segment: bytes
+        error: bytes
+        magic, status, segment, error = _RESPONSE.unpack(response)
+
+        if magic != _PROTOCOL_MAGIC:
+            raise DaemonError("Unexpected response from pricing daemon")
+
+        if status != _STATUS_OK:
+            raise DaemonError(error.split(b"\0", 1)[0].decode())
+
+        return segment.split(b"\0", 1)[0].decode()
+
+    def _recv_exact(self, size: int) -> bytes:
+        chunks: list[bytes] = []
+
+        while size > 0:
+            chunk: bytes = self._sock.recv(size)
+
+            if not chunk:
+                raise ConnectionError("Pricing daemon closed the connection")
+
+            chunks.append(chunk)
+            size -= len(chunk)
+
+        return b"".join(chunks)
+
+    def _map(self, segment: str) -> mmap.mmap:
+        if segment in self._mapped:
+            self._mapped.move_to_end(segment)
+            return self._mapped[segment]
+
+        # Map the segment file directly (multiprocessing.shared_memory would register it with the resource tracker,
+        # which unlinks segments it doesn't own on exit)
+        fd: int = os.open(os.path.join(_SHM_DIR, segment.lstrip("/")), os.O_RDONLY)
+
+        try:
+            buf: mmap.mmap = mmap.mmap(fd, 0, access=mmap.ACCESS_READ)
+        finally:
+            os.close(fd)
+
+        # Numpy views keep their mapping alive, so dropping our reference only unmaps once they're gone too
+        self._mapped[segment] = buf
+
+        if len(self._mapped) > self._max_mapped:
+            self._mapped.popitem(last=False)
+
+        return buf
+
+    def _views(self, buf: mmap.mmap, greek_idx: int) -> tuple[np.ndarray, ...]:
+        magic: int
+        n_sigma: int
+        n_strike: int
+        n_grids: int
+        data_offset: int
+        grid_stride: int
+        magic, _, n_sigma, n_strike, n_grids, data_offset, grid_stride = _SEGMENT_HEADER.unpack_from(buf)
+
+        if magic != _SEGMENT_MAGIC:
+            raise DaemonError("Invalid shared-memory segment")
+
+        # Grids are stored option type major, then greek type, each in column-major order
+        n_opt_types: int = 4
+        n_greeks: int = n_grids // n_opt_types
+        return tuple(
+            np.ndarray(
+                shape=(n_sigma, n_strike),
+                dtype=np.float64,
+                buffer=buf,
+                offset=data_offset + (opt_idx * n_greeks + greek_idx) * grid_stride,
+                order="F",
+            )
+            for opt_idx in range(n_opt_types)
+        )
+
+    def _close(self) -> None:
+        if self._sock is not None:
+            self._sock.close()
+            self._sock = None
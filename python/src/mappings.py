@@ -7,7 +7,7 @@ GREEK_ENUM: enum.Enum = CppPricingEngine.OptionsManager.GreekType
 OPT_ENUM: enum.Enum = CppPricingEngine.OptionsManager.OptionType
 
 # Make sure we're not missing enum options
-assert GREEK_ENUM.COUNT.value == GREEK_ENUM.Rho.value + 1, "Missing greek type enums value(s)"
+assert GREEK_ENUM.COUNT.value == GREEK_ENUM.Charm.value + 1, "Missing greek type enums value(s)"
 assert OPT_ENUM.COUNT.value == OPT_ENUM.EuroPut.value + 1, "Missing option type enums value(s)"
 
 class OptionTypeEntry(NamedTuple):
@@ -36,4 +36,7 @@ GREEK_TYPES: dict[int, GreekTypeEntry] = {
     GREEK_ENUM.Vega.value: GreekTypeEntry("Vega", "\u03bd (Vega)"),
     GREEK_ENUM.Theta.value: GreekTypeEntry("Theta", "\u0398 (Theta)"),
     GREEK_ENUM.Rho.value: GreekTypeEntry("Rho", "\u03c1 (Rho)"),
+    GREEK_ENUM.Vanna.value: GreekTypeEntry("Vanna", "Vanna"),
+    GREEK_ENUM.Volga.value: GreekTypeEntry("Volga", "Volga"),
+    GREEK_ENUM.Charm.value: GreekTypeEntry("Charm", "Charm"),
 }
@@ -1,17 +1,88 @@
 import CppPricingEngine
+import enum
 import logging
 import numpy as np
+import os
 from config import SETTINGS
-from CppPricingEngine import linspace
+from CppPricingEngine import make_axis
+from daemon_client import DaemonClient
 from mappings import GREEK_ENUM
+from slider import compute_strike_slider
+from typing import Optional
+
+
+def warmup_requests() -> list[dict]:
+    # Default view plus ENGINE_WARMUP_STEPS input steps either side of the default spot, tau, r and q, one parameter at
+    # a time (the strike window follows spot like the strike slider does); values are rounded the way the inputs
+    # produce them so they hit the same cache keys
+    if not SETTINGS.ENGINE_WARMUP:
+        return []
+
+    defaults: dict[str, float] = {
+        "spot": SETTINGS.SPOT_DEFAULT,
+        "tau": SETTINGS.TAU_DEFAULT,
+        "r": SETTINGS.RATE_DEFAULT,
+        "q": SETTINGS.DIV_DEFAULT,
+    }
+    steps: dict[str, float] = {
+        "spot": SETTINGS.SPOT_STEP,
+        "tau": SETTINGS.TAU_STEP,
+        "r": SETTINGS.RATE_STEP,
+        "q": SETTINGS.DIV_STEP,
+    }
+    views: list[dict[str, float]] = [defaults]
+
+    for param, step in steps.items():
+        for offset in range(1, SETTINGS.ENGINE_WARMUP_STEPS + 1):
+            for sign in (-1, 1):
+                views.append({**defaults, param: round(defaults[param] + sign * offset * step, 10)})
+
+    requests: list[dict] = []
+
+    for view in views:
+        strike_range: list[float] = compute_strike_slider(view["spot"]).value
+        requests.append(
+            dict(
+                n_sigma=SETTINGS.GRID_RESOLUTION,
+                n_strike=SETTINGS.GRID_RESOLUTION,
+                sigma_lo=SETTINGS.SIGMA_DEFAULTS[0],
+                sigma_hi=SETTINGS.SIGMA_DEFAULTS[1],
+                strike_lo=strike_range[0],
+                strike_hi=strike_range[1],
+                sigma_spacing=CppPricingEngine.OptionsManager.AxisSpacing[SETTINGS.ENGINE_SIGMA_SPACING],
+                strike_spacing=CppPricingEngine.OptionsManager.AxisSpacing[SETTINGS.ENGINE_STRIKE_SPACING],
+                **view,
+            )
+        )
+
+    return requests
 
 
 class PricingService:
-    # Class handles all c++ pricing interactions
-    if SETTINGS.ENGINE_THREADS is None:
-        manager: CppPricingEngine.OptionsManager = CppPricingEngine.OptionsManager(capacity=SETTINGS.ENGINE_CAPACITY)
+    # Class handles all c++ pricing interactions (when a pricing daemon socket is configured, every worker process
+    # shares the daemon's thread pool and cache instead of building its own; with a shared cache name, each worker
+    # prices in-process but publishes results that every other worker maps without recomputing)
+    if SETTINGS.ENGINE_SOCKET is not None:
+        manager: CppPricingEngine.OptionsManager | DaemonClient = DaemonClient(SETTINGS.ENGINE_SOCKET)
     else:
-        manager = CppPricingEngine.OptionsManager(capacity=SETTINGS.ENGINE_CAPACITY, n_threads=SETTINGS.ENGINE_THREADS)
+        manager = CppPricingEngine.OptionsManager(
+            capacity=SETTINGS.ENGINE_CAPACITY,
+            n_threads=SETTINGS.ENGINE_THREADS or 0,
+            affinity=CppPricingEngine.OptionsManager.ThreadAffinity[SETTINGS.ENGINE_AFFINITY],
+            partitions=SETTINGS.ENGINE_PARTITIONS,
+            cache_policy=CppPricingEngine.OptionsManager.CachePolicy[SETTINGS.ENGINE_CACHE_POLICY],
+            cold_capacity=SETTINGS.ENGINE_COLD_CAPACITY,
+            cold_tolerance=SETTINGS.ENGINE_COLD_TOLERANCE,
+            tree_depth=SETTINGS.ENGINE_TREE_DEPTH,
+            truncation=SETTINGS.ENGINE_TRUNCATION,
+            control_variate=SETTINGS.ENGINE_CONTROL_VARIATE,
+            preview_stride=SETTINGS.ENGINE_PREVIEW_STRIDE,
+            preview_depth=SETTINGS.ENGINE_PREVIEW_DEPTH,
+            shared_cache=SETTINGS.ENGINE_SHARED_CACHE,
+            shared_capacity=SETTINGS.ENGINE_SHARED_CAPACITY,
+            coalesce_ms=SETTINGS.ENGINE_COALESCE_MS,
+            warmup=warmup_requests(),
+        )
 
     engine_logger: logging.Logger = logging.getLogger(__name__)
 
@@ -24,16 +95,19 @@ class PricingService:
         sigma_range: list[float],
         strike_range: list[float],
         tau: float,
-    ) -> tuple[tuple[np.ndarray, ...], np.ndarray, np.ndarray]:
+    ) -> tuple[Optional[tuple[np.ndarray, ...]], np.ndarray, np.ndarray, bool, Optional[tuple[float, float]]]:
+        # Returns (grids, strikes, sigmas, final, color_range); in progressive mode grids may be a coarse preview
+        # (final is False until the surface is fully refined) or None while the preview is still being computed.
+        # color_range is the engine's (min, max) across option types, or None when the caller has to derive it
         try:
-            # Generate linear axis arrays for the heatmap grid coordinates (CppPricingEngine.linspace is used for
+            # Generate axis arrays for the heatmap grid coordinates (CppPricingEngine.make_axis is used for
             # consistency with the C++ engine)
-            sigmas: np.ndarray = linspace(SETTINGS.GRID_RESOLUTION, sigma_range[0], sigma_range[1])
-            strikes: np.ndarray = linspace(SETTINGS.GRID_RESOLUTION, strike_range[0], strike_range[1])
+            sigma_spacing: enum.Enum = CppPricingEngine.OptionsManager.AxisSpacing[SETTINGS.ENGINE_SIGMA_SPACING]
+            strike_spacing: enum.Enum = CppPricingEngine.OptionsManager.AxisSpacing[SETTINGS.ENGINE_STRIKE_SPACING]
+            sigmas: np.ndarray = make_axis(sigma_spacing, SETTINGS.GRID_RESOLUTION, sigma_range[0], sigma_range[1])
+            strikes: np.ndarray = make_axis(strike_spacing, SETTINGS.GRID_RESOLUTION, strike_range[0], strike_range[1])
 
-            # Retrieve pricing grids from the underlying C++ OptionsManager (either retrieves cached results or
-            # generates new ones)
-            grids: tuple[np.ndarray, ...] = PricingService.manager.get_greek(
+            args: tuple = (
                 GREEK_ENUM(greek_idx),
                 SETTINGS.GRID_RESOLUTION,
                 SETTINGS.GRID_RESOLUTION,
@@ -47,8 +121,49 @@ class PricingService:
                 tau,
             )
 
+            # Progressive mode returns the latest refinement stage right away (the daemon has no progressive mode)
+            if SETTINGS.ENGINE_PROGRESSIVE and not isinstance(PricingService.manager, DaemonClient):
+                final: bool
+                grids: Optional[tuple[np.ndarray, ...]]
+                _, final, grids = PricingService.manager.get_greek_progressive(
+                    *args, sigma_spacing=sigma_spacing, strike_spacing=strike_spacing
+                )
+                return grids, strikes, sigmas, final, None
+
+            # The daemon only serves full-precision grids
+            if isinstance(PricingService.manager, DaemonClient):
+                grids = PricingService.manager.get_greek(
+                    *args, sigma_spacing=sigma_spacing, strike_spacing=strike_spacing
+                )
+                return grids, strikes, sigmas, True, None
+
+            # Retrieve pricing grids from the underlying C++ OptionsManager (either retrieves cached results or
+            # generates new ones) along with their shared color range, in the configured float encoding (the
+            # quantized encodings are left to clients that plot the codes themselves)
+            color_range: tuple[float, float]
+            grids, color_range, _ = PricingService.manager.get_heatmap(
+                *args,
+                sigma_spacing=sigma_spacing,
+                strike_spacing=strike_spacing,
+                encoding=CppPricingEngine.OptionsManager.HeatmapEncoding[SETTINGS.ENGINE_HEATMAP_ENCODING],
+            )
+
         except Exception as e:
             PricingService.engine_logger.error(f"Engine failure for Greek {greek_idx}: {e}", exc_info=True)
             raise e
 
-        return grids, strikes, sigmas
+        return grids, strikes, sigmas, True, color_range
+
+    @staticmethod
+    def record_request(
+        spot: float, r: float, q: float, sigma_range: list[float], strike_range: list[float], tau: float
+    ) -> None:
+        # Append the request to the trace file replayed by PricingEngineReplay (each worker process is one session)
+        if SETTINGS.ENGINE_TRACE_FILE is None:
+            return
+
+        with open(SETTINGS.ENGINE_TRACE_FILE, "a") as trace:
+            trace.write(
+                f"{os.getpid()} {spot} {r} {q} {sigma_range[0]} {sigma_range[1]} {strike_range[0]} {strike_range[1]} "
+                f"{tau}\n"
+            )
@@ -0,0 +1,146 @@
+#include <BS_thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+#include "OptionsVisualizer/batch/BatchReader.hpp"
+#include "OptionsVisualizer/batch/BatchWriter.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+
+// Standalone batch pricer: reads surfaces/contracts from a text file, prices
+// them on a shared thread pool and streams the results to a binary file as
+// they complete (see BatchReader and BatchWriter for the file formats). At most
+// `--in-flight` surfaces are held in memory at once and nothing is cached
+
+namespace {
+
+struct CliOptions {
+  std::string input{};
+  std::string output{};
+  std::size_t nThreads{0};  // 0 -> use all available hardware threads
+  std::size_t nInFlight{0};
+  batch::ValueFormat format{batch::ValueFormat::Float64};
+};
+
+void printUsage(const std::string_view prog) {
+  std::cerr << "Usage: " << prog
+            << " <input> <output> [--threads N] [--in-flight N] [--float32]\n";
+}
+
+[[nodiscard]] CliOptions parseArgs(const int argc, char** argv) {
+  CliOptions opts{};
+  std::vector<std::string_view> positional{};
+
+  for (int idx{1}; idx < argc; ++idx) {
+    const std::string_view arg{argv[idx]};
+
+    if (arg == "--float32") {
+      opts.format = batch::ValueFormat::Float32;
+    } else if (arg == "--threads" || arg == "--in-flight") {
+      if (idx + 1 >= argc) {
+        throw std::invalid_argument{"Missing value for " + std::string{arg}};
+      }
+
+      const std::size_t value{std::stoul(argv[++idx])};
+      (arg == "--threads" ? opts.nThreads : opts.nInFlight) = value;
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  if (positional.size() != 2) {
+    throw std::invalid_argument{"Expected an input and an output path"};
+  }
+
+  opts.input = positional[0];
+  opts.output = positional[1];
+  return opts;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CliOptions opts{};
+
+  try {
+    opts = parseArgs(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    batch::BatchReader reader{opts.input};
+    batch::BatchWriter writer{opts.output, opts.format};
+
+    BS::priority_thread_pool pool{opts.nThreads == 0
+                                      ? std::thread::hardware_concurrency()
+                                      : opts.nThreads};
+
+    // Each driver prices one surface at a time (the trees of a surface are
+    // spread over the pool), so the number of drivers bounds the number of
+    // result grids alive at once. A single surface already submits 18 tree
+    // tasks, so a handful of drivers is enough to keep the pool saturated
+    const std::size_t nDrivers{
+        opts.nInFlight == 0 ? std::max(pool.get_thread_count() / 4 + 1,
+                                       std::size_t{2})
+                            : opts.nInFlight};
+
+    std::exception_ptr failure{nullptr};
+    std::mutex failureMutex{};
+    std::atomic_bool failed{false};
+
+    {
+      std::vector<std::jthread> drivers{};
+      drivers.reserve(nDrivers);
+
+      for (std::size_t idx{0}; idx < nDrivers; ++idx) {
+        drivers.emplace_back([&] {
+          try {
+            while (!failed) {
+              const std::optional<batch::BatchJob> job{reader.next()};
+
+              if (!job) {
+                break;
+              }
+
+              const PricingSurface surface{
+                  job->nSigma_,  job->nStrike_, job->spot_,     job->r_,
+                  job->q_,       job->sigmaLo_, job->sigmaHi_,  job->strikeLo_,
+                  job->strikeHi_, job->tau_,    pool};
+              writer.write(*job, surface.calculateGrids());
+            }
+          } catch (...) {
+            failed = true;
+            const std::lock_guard lock{failureMutex};
+
+            if (!failure) {
+              failure = std::current_exception();
+            }
+          }
+        });
+      }
+    }  // join drivers
+
+    if (failure) {
+      std::rethrow_exception(failure);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Batch pricing failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
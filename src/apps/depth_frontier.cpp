@@ -0,0 +1,344 @@
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+
+// Accuracy-versus-latency frontier of the American trees: prices a fixed set
+// of surfaces against a much deeper reference tree for every combination of
+// depth and lattice options (truncation, control variate) and reports the
+// error percentiles of each greek next to the wall time per surface, so the
+// production tree settings (ENGINE_TREE_DEPTH, ENGINE_TRUNCATION,
+// ENGINE_CONTROL_VARIATE) can be picked from data
+
+namespace {
+
+struct CliOptions {
+  std::vector<Eigen::Index> depths{25, 50, 100, 200, 400};
+  Eigen::Index referenceDepth{1000};
+  double truncation{6.0};  // truncated variants are skipped when 0
+  std::size_t repeats{3};  // timed runs per configuration (the best is kept)
+  std::size_t nThreads{0};  // 0 -> use all available hardware threads
+  std::string csv{};        // where to write the rows (not written when empty)
+};
+
+// Market parameters of one surface in the contract set (every surface has the
+// same sigma and strike axes)
+struct Scenario {
+  double r_;
+  double q_;
+  double tau_;
+};
+
+// Fixed contract set: short to long maturities under low, typical and high
+// rate/dividend regimes (the high dividend yield makes early exercise of the
+// calls matter too), over the default heatmap ranges around spot
+constexpr double spot{100.0};
+constexpr double taus[]{0.1, 0.5, 1.0, 2.0};
+constexpr std::array<std::array<double, 2>, 3> rates{
+    {{0.01, 0.0}, {0.05, 0.02}, {0.08, 0.06}}};
+constexpr Eigen::Index nSigma{6};
+constexpr Eigen::Index nStrike{7};
+constexpr double sigmaRange[]{0.1, 0.6};
+constexpr double strikeRange[]{70.0, 130.0};
+
+constexpr Enums::OptionType amerTypes[]{Enums::OptionType::AmerCall,
+                                        Enums::OptionType::AmerPut};
+constexpr std::size_t nGreeks{Enums::idx(Enums::GreekType::COUNT)};
+constexpr std::string_view greekNames[]{"price", "delta", "gamma",
+                                        "vega",  "theta", "rho",
+                                        "vanna", "volga", "charm"};
+static_assert(std::size(greekNames) == nGreeks);
+
+constexpr double percentiles[]{50.0, 90.0, 99.0, 100.0};
+
+void printUsage(const std::string_view prog) {
+  std::cerr << "Usage: " << prog
+            << " [--depths 25,50,...] [--reference-depth N]"
+               " [--truncation K] [--repeats N] [--threads N] [--csv path]\n";
+}
+
+[[nodiscard]] std::vector<Eigen::Index> parseDepths(const std::string& list) {
+  std::vector<Eigen::Index> depths{};
+  std::istringstream items{list};
+  std::string item{};
+
+  while (std::getline(items, item, ',')) {
+    depths.push_back(std::stol(item));
+
+    if (depths.back() < 1) {
+      throw std::invalid_argument{"Depths must be positive"};
+    }
+  }
+
+  if (depths.empty()) {
+    throw std::invalid_argument{"Expected at least one depth"};
+  }
+
+  return depths;
+}
+
+[[nodiscard]] CliOptions parseArgs(const int argc, char** argv) {
+  CliOptions opts{};
+
+  for (int idx{1}; idx < argc; ++idx) {
+    const std::string_view arg{argv[idx]};
+
+    if (idx + 1 >= argc) {
+      throw std::invalid_argument{"Missing value for " + std::string{arg}};
+    }
+
+    const std::string value{argv[++idx]};
+
+    if (arg == "--depths") {
+      opts.depths = parseDepths(value);
+    } else if (arg == "--reference-depth") {
+      opts.referenceDepth = std::stol(value);
+    } else if (arg == "--truncation") {
+      opts.truncation = std::stod(value);
+    } else if (arg == "--repeats") {
+      opts.repeats = std::max<std::size_t>(std::stoul(value), 1);
+    } else if (arg == "--threads") {
+      opts.nThreads = std::stoul(value);
+    } else if (arg == "--csv") {
+      opts.csv = value;
+    } else {
+      throw std::invalid_argument{"Unknown argument: " + std::string{arg}};
+    }
+  }
+
+  if (opts.referenceDepth <= *std::ranges::max_element(opts.depths)) {
+    throw std::invalid_argument{
+        "The reference depth must exceed every swept depth"};
+  }
+
+  return opts;
+}
+
+[[nodiscard]] std::vector<Scenario> contractSet() {
+  std::vector<Scenario> scenarios{};
+
+  for (const auto& [r, q] : rates) {
+    for (const double tau : taus) {
+      scenarios.push_back(Scenario{.r_ = r, .q_ = q, .tau_ = tau});
+    }
+  }
+
+  return scenarios;
+}
+
+// Grids of every surface in the contract set and the wall time it took to
+// price them
+struct Run {
+  std::vector<GridBlock> grids_;
+  double seconds_;
+};
+
+// Price every surface of the contract set with the given tree settings,
+// keeping the fastest of `repeats` runs (surfaces are priced one after the
+// other with their trees spread over the pool, as the manager does for a
+// single request)
+
+[[nodiscard]] Run priceContractSet(
+    const std::vector<Scenario>& scenarios,
+    const models::trinomial::TreeSettings& settings,
+    BS::priority_thread_pool& pool, const std::size_t repeats) {
+  const Eigen::ArrayXd sigmas{linspace(nSigma, sigmaRange[0], sigmaRange[1])};
+  const Eigen::ArrayXd strikes{
+      linspace(nStrike, strikeRange[0], strikeRange[1])};
+  Run run{.grids_ = {}, .seconds_ = std::numeric_limits<double>::infinity()};
+
+  for (std::size_t repeat{0}; repeat < repeats; ++repeat) {
+    std::vector<GridBlock> grids{};
+    grids.reserve(scenarios.size());
+    const auto start{std::chrono::steady_clock::now()};
+
+    for (const Scenario& s : scenarios) {
+      const PricingSurface surface{sigmas, strikes, spot, s.r_,
+                                   s.q_,   s.tau_,  pool, settings};
+      grids.push_back(surface.calculateGrids());
+    }
+
+    const std::chrono::duration<double> elapsed{
+        std::chrono::steady_clock::now() - start};
+    run.seconds_ = std::min(run.seconds_, elapsed.count());
+    run.grids_ = std::move(grids);
+  }
+
+  return run;
+}
+
+// Nearest-rank percentile of sorted values
+[[nodiscard]] double percentile(const std::vector<double>& sorted,
+                                const double pct) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+
+  const auto rank{static_cast<std::size_t>(
+      std::ceil(pct / 100.0 * static_cast<double>(sorted.size())))};
+  return sorted[std::clamp(rank, std::size_t{1}, sorted.size()) - 1];
+}
+
+// Sorted absolute errors of one greek of both American options against the
+// reference, over every cell of every surface
+[[nodiscard]] std::vector<double> errors(
+    const std::vector<GridBlock>& grids,
+    const std::vector<GridBlock>& reference, const std::size_t greekIdx) {
+  std::vector<double> errs{};
+
+  for (std::size_t surface{0}; surface < grids.size(); ++surface) {
+    for (const Enums::OptionType optType : amerTypes) {
+      const std::size_t idx{Enums::idx(optType) * nGreeks + greekIdx};
+      const GridBlock::ConstGrid got{grids[surface][idx]};
+      const GridBlock::ConstGrid want{reference[surface][idx]};
+
+      for (Eigen::Index cell{0}; cell < got.size(); ++cell) {
+        errs.push_back(std::abs(got.data()[cell] - want.data()[cell]));
+      }
+    }
+  }
+
+  std::sort(errs.begin(), errs.end());
+  return errs;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CliOptions opts{};
+
+  try {
+    opts = parseArgs(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    BS::priority_thread_pool pool{opts.nThreads == 0
+                                      ? std::thread::hardware_concurrency()
+                                      : opts.nThreads};
+    const std::vector<Scenario> scenarios{contractSet()};
+
+    // The reference keeps the full lattice without the control variate
+    const models::trinomial::TreeSettings referenceTree{
+        .depth_ = opts.referenceDepth};
+    const Run reference{priceContractSet(scenarios, referenceTree, pool, 1)};
+    std::cout << std::fixed << std::setprecision(3) << scenarios.size()
+              << " surfaces of " << nSigma << " x " << nStrike
+              << " cells, reference depth " << opts.referenceDepth << " ("
+              << reference.seconds_ << " s)\n"
+              << "Absolute errors of both American options (p50/p90/p99/max "
+                 "for price, p99 for the greeks)\n\n";
+
+    std::ofstream csv{};
+
+    if (!opts.csv.empty()) {
+      csv.open(opts.csv);
+
+      if (!csv) {
+        throw std::runtime_error{"Could not write CSV: " + opts.csv};
+      }
+
+      csv << "depth,truncation,control_variate,ms_per_surface,greek";
+
+      for (const double pct : percentiles) {
+        csv << ",p" << pct;
+      }
+
+      csv << '\n' << std::setprecision(10);
+    }
+
+    std::cout << " depth  trunc  cv  ms/surface   price p50   price p90"
+                 "   price p99   price max";
+
+    for (std::size_t greekIdx{1}; greekIdx < nGreeks; ++greekIdx) {
+      std::cout << std::setw(12) << greekNames[greekIdx];
+    }
+
+    std::cout << '\n' << std::scientific << std::setprecision(2);
+
+    std::vector<double> truncations{0.0};
+
+    if (opts.truncation > 0.0) {
+      truncations.push_back(opts.truncation);
+    }
+
+    for (const Eigen::Index depth : opts.depths) {
+      for (const double truncation : truncations) {
+        for (const bool controlVariate : {false, true}) {
+          const Run run{priceContractSet(
+              scenarios,
+              models::trinomial::TreeSettings{.depth_ = depth,
+                                              .truncation_ = truncation,
+                                              .controlVariate_ =
+                                                  controlVariate},
+              pool, opts.repeats)};
+          const double msPerSurface{run.seconds_ * 1e3 /
+                                    static_cast<double>(scenarios.size())};
+
+          std::cout << std::setw(6) << depth << std::fixed
+                    << std::setprecision(1) << std::setw(7) << truncation
+                    << std::setw(4) << (controlVariate ? "y" : "n")
+                    << std::setprecision(3) << std::setw(12) << msPerSurface
+                    << std::scientific << std::setprecision(2);
+
+          for (std::size_t greekIdx{0}; greekIdx < nGreeks; ++greekIdx) {
+            const std::vector<double> errs{
+                errors(run.grids_, reference.grids_, greekIdx)};
+
+            if (greekIdx == 0) {
+              for (const double pct : percentiles) {
+                std::cout << std::setw(12) << percentile(errs, pct);
+              }
+            } else {
+              std::cout << std::setw(12) << percentile(errs, 99.0);
+            }
+
+            if (csv.is_open()) {
+              csv << depth << ',' << truncation << ','
+                  << (controlVariate ? 1 : 0) << ',' << msPerSurface << ','
+                  << greekNames[greekIdx];
+
+              for (const double pct : percentiles) {
+                csv << ',' << percentile(errs, pct);
+              }
+
+              csv << '\n';
+            }
+          }
+
+          std::cout << '\n';
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Benchmark failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
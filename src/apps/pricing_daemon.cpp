@@ -0,0 +1,367 @@
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/ipc/DaemonProtocol.hpp"
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+#include "OptionsVisualizer/lru/LRUCache.hpp"
+#include "OptionsVisualizer/pricing/PricingParams.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+// Local pricing server: a single OptionsManager (one thread pool) shared by
+// every process on the host. Clients connect over a Unix domain socket, send
+// DaemonRequest messages and receive the name of a shared-memory segment
+// holding the results, which they map read-only instead of deserializing. The
+// published segments double as the host-wide cache (least recently used
+// segments are unlinked once `--capacity` is exceeded)
+
+namespace {
+
+struct CliOptions {
+  std::string socketPath{"/tmp/options_visualizer.sock"};
+  std::size_t capacity{16};
+  std::size_t nThreads{0};  // 0 -> use all available hardware threads
+  double coalesceMs{0.0};   // 0 -> price every request on its own
+  Enums::ThreadAffinity affinity{Enums::ThreadAffinity::Off};
+  Eigen::Index partitions{1};  // 0 -> one block per NUMA node
+};
+
+// A connection's thread and whether it has finished serving, so the acceptor
+// can join it instead of holding every thread until shutdown (the thread is
+// declared last so it's joined before the flag is destroyed)
+struct Handler {
+  std::atomic<bool> done{false};
+  std::jthread thread{};
+};
+
+[[nodiscard]] CliOptions parseArgs(const int argc, char** argv) {
+  CliOptions opts{};
+
+  for (int idx{1}; idx < argc; ++idx) {
+    const std::string_view arg{argv[idx]};
+
+    if (idx + 1 >= argc) {
+      throw std::invalid_argument{"Missing value for " + std::string{arg}};
+    }
+
+    if (arg == "--socket") {
+      opts.socketPath = argv[++idx];
+    } else if (arg == "--capacity") {
+      opts.capacity = std::stoul(argv[++idx]);
+    } else if (arg == "--threads") {
+      opts.nThreads = std::stoul(argv[++idx]);
+    } else if (arg == "--coalesce-ms") {
+      opts.coalesceMs = std::stod(argv[++idx]);
+    } else if (arg == "--affinity") {
+      const std::string_view value{argv[++idx]};
+
+      if (value == "Off") {
+        opts.affinity = Enums::ThreadAffinity::Off;
+      } else if (value == "Core") {
+        opts.affinity = Enums::ThreadAffinity::Core;
+      } else if (value == "Node") {
+        opts.affinity = Enums::ThreadAffinity::Node;
+      } else {
+        throw std::invalid_argument{"Unknown affinity: " + std::string{value}};
+      }
+    } else if (arg == "--partitions") {
+      opts.partitions = std::stol(argv[++idx]);
+    } else {
+      throw std::invalid_argument{"Unknown argument: " + std::string{arg}};
+    }
+  }
+
+  return opts;
+}
+
+// Read/write exactly `size` bytes (false if the peer closed the connection)
+[[nodiscard]] bool readAll(const int fd, void* const buf,
+                           const std::size_t size) {
+  auto* ptr{static_cast<char*>(buf)};
+  std::size_t remaining{size};
+
+  while (remaining > 0) {
+    const ssize_t n{::read(fd, ptr, remaining)};
+
+    if (n == 0 || (n == -1 && errno != EINTR)) {
+      return false;
+    }
+
+    if (n > 0) {
+      ptr += n;
+      remaining -= static_cast<std::size_t>(n);
+    }
+  }
+
+  return true;
+}
+
+[[nodiscard]] bool writeAll(const int fd, const void* const buf,
+                            const std::size_t size) {
+  const auto* ptr{static_cast<const char*>(buf)};
+  std::size_t remaining{size};
+
+  while (remaining > 0) {
+    const ssize_t n{::send(fd, ptr, remaining, MSG_NOSIGNAL)};
+
+    if (n == -1 && errno != EINTR) {
+      return false;
+    }
+
+    if (n > 0) {
+      ptr += n;
+      remaining -= static_cast<std::size_t>(n);
+    }
+  }
+
+  return true;
+}
+
+template <std::size_t N>
+void copyString(std::array<char, N>& dst, const std::string_view src) {
+  const std::size_t len{std::min(src.size(), N - 1)};
+  std::memcpy(dst.data(), src.data(), len);
+  dst[len] = '\0';
+}
+
+class PricingDaemon {
+  // --- Data members
+
+  // Only the latest surface needs to stay in the manager (results are served
+  // from the published segments)
+  OptionsManager manager_;
+  std::mutex managerMutex_{};
+
+  // Published segments keyed by pricing parameters
+  LRUCache<PricingParams, ipc::SharedGrids, PricingParamsHash> segments_;
+  std::mutex segmentsMutex_{};
+  std::uint64_t nSegments_{0};
+
+ public:
+  explicit PricingDaemon(const CliOptions& opts)
+      : manager_{ManagerConfig{.capacity_ = 1,
+                               .nThreads_ = opts.nThreads,
+                               .affinity_ = opts.affinity,
+                               .tree_ = {.partitions_ = opts.partitions},
+                               .coalesceMs_ = opts.coalesceMs}},
+        segments_{std::max(opts.capacity, std::size_t{1})} {}
+
+  // Serve requests on a connected socket until the client disconnects
+  void serve(const int fd) {
+    ipc::DaemonRequest request{};
+
+    while (readAll(fd, &request, sizeof(request))) {
+      const ipc::DaemonResponse response{handle(request)};
+
+      if (!writeAll(fd, &response, sizeof(response))) {
+        break;
+      }
+    }
+  }
+
+ private:
+  [[nodiscard]] ipc::DaemonResponse handle(const ipc::DaemonRequest& req) {
+    ipc::DaemonResponse response{.magic_ = ipc::protocolMagic,
+                                 .status_ = ipc::DaemonStatus::Ok,
+                                 .segment_ = {},
+                                 .error_ = {}};
+
+    if (req.magic_ != ipc::protocolMagic ||
+        req.version_ != ipc::protocolVersion || req.nSigma_ < 1 ||
+        req.nStrike_ < 1) {
+      response.status_ = ipc::DaemonStatus::BadRequest;
+      copyString(response.error_, "Malformed pricing request");
+      return response;
+    }
+
+    try {
+      copyString(response.segment_, publish(req));
+    } catch (const std::exception& e) {
+      response.status_ = ipc::DaemonStatus::PricingError;
+      copyString(response.error_, e.what());
+    }
+
+    return response;
+  }
+
+  // Retrieve the segment holding the results for a request, computing and
+  // publishing them first if needed
+  [[nodiscard]] std::string publish(const ipc::DaemonRequest& req) {
+    const PricingParams params{req.nSigma_,   req.nStrike_,  req.spot_,
+                               req.r_,        req.q_,        req.sigmaLo_,
+                               req.sigmaHi_,  req.strikeLo_, req.strikeHi_,
+                               req.tau_};
+
+    // Cache hits never wait on a computation in progress
+    if (const std::lock_guard lock{segmentsMutex_}; segments_.contains(params)) {
+      return segments_.get(params).name();
+    }
+
+    // Surfaces are priced outside the manager lock, so requests from several
+    // clients are priced concurrently (or coalesced with --coalesce-ms) and
+    // identical ones share a task
+    std::shared_ptr<SurfaceTask> task{};
+
+    {
+      const std::lock_guard managerLock{managerMutex_};
+      task = manager_.submit(linspace(req.nSigma_, req.sigmaLo_, req.sigmaHi_),
+                             linspace(req.nStrike_, req.strikeLo_,
+                                      req.strikeHi_),
+                             req.spot_, req.r_, req.q_, req.tau_);
+    }
+
+    const std::shared_ptr<const SurfaceTask::GridArray> grids{task->grids()};
+    const std::lock_guard lock{segmentsMutex_};
+
+    // Another client may have published the same surface while we waited
+    if (segments_.contains(params)) {
+      return segments_.get(params).name();
+    }
+
+    const std::string name{"/ovpd-" + std::to_string(::getpid()) + "-" +
+                           std::to_string(nSegments_++)};
+    segments_.set(params, ipc::SharedGrids::create(name, *grids));
+    return name;
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CliOptions opts{};
+
+  try {
+    opts = parseArgs(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n'
+              << "Usage: " << argv[0]
+              << " [--socket PATH] [--capacity N] [--threads N]"
+                 " [--coalesce-ms MS] [--affinity Off|Core|Node]"
+                 " [--partitions N]\n";
+    return EXIT_FAILURE;
+  }
+
+  // Block termination signals in every thread; the main thread waits for them
+  // explicitly so shutdown can clean up the socket and segments
+  sigset_t signals{};
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  try {
+    PricingDaemon daemon{opts};
+
+    const int listenFd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+
+    if (listenFd == -1) {
+      throw std::system_error{errno, std::generic_category(), "socket"};
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+
+    if (opts.socketPath.size() >= sizeof(addr.sun_path)) {
+      throw std::invalid_argument{"Socket path is too long"};
+    }
+
+    std::memcpy(addr.sun_path, opts.socketPath.c_str(),
+                opts.socketPath.size() + 1);
+    ::unlink(opts.socketPath.c_str());
+
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr),
+               sizeof(addr)) == -1 ||
+        ::listen(listenFd, SOMAXCONN) == -1) {
+      throw std::system_error{errno, std::generic_category(),
+                              "bind " + opts.socketPath};
+    }
+
+    std::mutex connectionsMutex{};
+    std::list<int> connections{};
+    std::list<Handler> handlers{};
+
+    std::jthread acceptor{[&] {
+      while (true) {
+        const int fd{::accept(listenFd, nullptr, nullptr)};
+
+        if (fd == -1) {
+          if (errno == EINTR || errno == ECONNABORTED) {
+            continue;
+          }
+
+          break;  // listening socket was shut down
+        }
+
+        const std::lock_guard lock{connectionsMutex};
+
+        // Reap connections that have closed since the last accept (each one
+        // sets its flag under the lock, so joining it here only waits for the
+        // thread to return)
+        handlers.remove_if(
+            [](const Handler& handler) { return handler.done.load(); });
+
+        connections.push_back(fd);
+        Handler& handler{handlers.emplace_back()};
+        handler.thread = std::jthread{[&, fd, &done = handler.done] {
+          daemon.serve(fd);
+
+          const std::lock_guard handlerLock{connectionsMutex};
+          connections.remove(fd);
+          ::close(fd);
+          done.store(true);
+        }};
+      }
+    }};
+
+    std::cerr << "Pricing daemon listening on " << opts.socketPath << '\n';
+
+    int sig{0};
+    sigwait(&signals, &sig);
+
+    // Stop accepting, then wake every connection blocked on a read
+    ::shutdown(listenFd, SHUT_RDWR);
+    acceptor.join();
+    ::close(listenFd);
+    ::unlink(opts.socketPath.c_str());
+
+    {
+      const std::lock_guard lock{connectionsMutex};
+
+      for (const int fd : connections) {
+        ::shutdown(fd, SHUT_RDWR);
+      }
+    }
+
+    handlers.clear();  // join handlers before the daemon unlinks its segments
+  } catch (const std::exception& e) {
+    std::cerr << "Pricing daemon failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
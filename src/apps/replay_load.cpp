@@ -0,0 +1,526 @@
+#include <sys/resource.h>
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+
+// Load generator for end-to-end cache and scheduling measurements: replays
+// heatmap requests from concurrent user sessions against one OptionsManager
+// (shared behind a mutex, like the pricing daemon's) and reports the latency
+// distribution, cache hit rate and peak memory. Traces are either read from a
+// file (e.g. recorded by the Dash app with ENGINE_TRACE_FILE) or generated from
+// random slider interactions that follow the steps and ranges of
+// python/src/config.py
+
+namespace {
+
+struct CliOptions {
+  std::string trace{};  // replayed trace (synthetic traffic when empty)
+  std::string save{};   // where to write the synthetic trace
+  std::size_t nSessions{4};
+  std::size_t nEvents{200};       // synthetic requests per session
+  std::size_t updatesPerDrag{1};  // 1 matches Dash's default mouseup sliders
+  std::size_t thinkMs{0};         // pause between a session's requests
+  std::uint64_t seed{1};
+  std::size_t nThreads{0};  // 0 -> use all available hardware threads
+  std::size_t capacity{16};
+  std::size_t coldCapacity{0};
+  Enums::CachePolicy cachePolicy{Enums::CachePolicy::LRU};
+  Eigen::Index resolution{12};
+  Eigen::Index treeDepth{models::trinomial::defaultDepth};
+};
+
+// One heatmap request (the greek isn't part of it since every greek of a
+// surface is priced and cached together)
+struct Event {
+  std::size_t session_;
+  double spot_;
+  double r_;
+  double q_;
+  double sigmaLo_;
+  double sigmaHi_;
+  double strikeLo_;
+  double strikeHi_;
+  double tau_;
+};
+
+// Range and step of one input (mirrors python/src/config.py)
+struct Slider {
+  double min_;
+  double max_;
+  double step_;
+};
+
+constexpr Slider spotInput{.min_ = 1.0, .max_ = 10000.0, .step_ = 0.01};
+constexpr Slider sigmaSlider{.min_ = 0.01, .max_ = 2.0, .step_ = 0.005};
+constexpr Slider tauInput{.min_ = 0.001, .max_ = 3.0, .step_ = 0.001};
+constexpr Slider rateInput{.min_ = -0.05, .max_ = 0.15, .step_ = 0.0001};
+constexpr Slider divInput{.min_ = 0.0, .max_ = 0.15, .step_ = 0.0001};
+constexpr double strikeStep{0.1};
+constexpr double strikeRangePcts[]{0.5, 1.5};
+constexpr double strikeValPcts[]{0.8, 1.2};
+
+void printUsage(const std::string_view prog) {
+  std::cerr << "Usage: " << prog
+            << " [trace] [--sessions N] [--events N] [--updates-per-drag N]"
+               " [--think-ms N] [--seed N] [--save path] [--threads N]"
+               " [--capacity N] [--cold-capacity N] [--policy LRU|TinyLFU]"
+               " [--resolution N] [--tree-depth N]\n";
+}
+
+[[nodiscard]] CliOptions parseArgs(const int argc, char** argv) {
+  CliOptions opts{};
+  std::vector<std::string_view> positional{};
+
+  for (int idx{1}; idx < argc; ++idx) {
+    const std::string_view arg{argv[idx]};
+
+    if (!arg.starts_with("--")) {
+      positional.push_back(arg);
+      continue;
+    }
+
+    if (idx + 1 >= argc) {
+      throw std::invalid_argument{"Missing value for " + std::string{arg}};
+    }
+
+    const std::string value{argv[++idx]};
+
+    if (arg == "--sessions") {
+      opts.nSessions = std::max<std::size_t>(std::stoul(value), 1);
+    } else if (arg == "--events") {
+      opts.nEvents = std::stoul(value);
+    } else if (arg == "--updates-per-drag") {
+      opts.updatesPerDrag = std::max<std::size_t>(std::stoul(value), 1);
+    } else if (arg == "--think-ms") {
+      opts.thinkMs = std::stoul(value);
+    } else if (arg == "--seed") {
+      opts.seed = std::stoull(value);
+    } else if (arg == "--save") {
+      opts.save = value;
+    } else if (arg == "--threads") {
+      opts.nThreads = std::stoul(value);
+    } else if (arg == "--capacity") {
+      opts.capacity = std::stoul(value);
+    } else if (arg == "--cold-capacity") {
+      opts.coldCapacity = std::stoul(value);
+    } else if (arg == "--policy") {
+      if (value != "LRU" && value != "TinyLFU") {
+        throw std::invalid_argument{"Unknown cache policy: " + value};
+      }
+
+      opts.cachePolicy = value == "LRU" ? Enums::CachePolicy::LRU
+                                        : Enums::CachePolicy::TinyLFU;
+    } else if (arg == "--resolution") {
+      opts.resolution = std::stol(value);
+    } else if (arg == "--tree-depth") {
+      opts.treeDepth = std::stol(value);
+    } else {
+      throw std::invalid_argument{"Unknown argument: " + std::string{arg}};
+    }
+  }
+
+  if (positional.size() > 1) {
+    throw std::invalid_argument{"Expected at most one trace path"};
+  }
+
+  if (!positional.empty()) {
+    opts.trace = positional[0];
+  }
+
+  return opts;
+}
+
+// --- Traces
+
+// One request per line: `session spot r q sigma_lo sigma_hi strike_lo
+// strike_hi tau` (blank lines and lines starting with `#` are ignored)
+[[nodiscard]] std::vector<Event> readTrace(const std::string& path) {
+  std::ifstream file{path};
+
+  if (!file) {
+    throw std::runtime_error{"Could not open trace: " + path};
+  }
+
+  std::vector<Event> events{};
+  std::string line{};
+  std::size_t lineNo{0};
+
+  while (std::getline(file, line)) {
+    ++lineNo;
+
+    if (line.find_first_not_of(" \t\r") == std::string::npos ||
+        line.front() == '#') {
+      continue;
+    }
+
+    std::istringstream fields{line};
+    Event event{};
+
+    if (!(fields >> event.session_ >> event.spot_ >> event.r_ >> event.q_ >>
+          event.sigmaLo_ >> event.sigmaHi_ >> event.strikeLo_ >>
+          event.strikeHi_ >> event.tau_)) {
+      throw std::invalid_argument{"Malformed trace line " +
+                                  std::to_string(lineNo)};
+    }
+
+    events.push_back(event);
+  }
+
+  return events;
+}
+
+void writeTrace(const std::string& path, const std::vector<Event>& events) {
+  std::ofstream file{path};
+
+  if (!file) {
+    throw std::runtime_error{"Could not write trace: " + path};
+  }
+
+  file << "# session spot r q sigma_lo sigma_hi strike_lo strike_hi tau\n"
+       << std::setprecision(10);
+
+  for (const Event& e : events) {
+    file << e.session_ << ' ' << e.spot_ << ' ' << e.r_ << ' ' << e.q_ << ' '
+         << e.sigmaLo_ << ' ' << e.sigmaHi_ << ' ' << e.strikeLo_ << ' '
+         << e.strikeHi_ << ' ' << e.tau_ << '\n';
+  }
+}
+
+// Snap a value onto an input's step grid within its range
+[[nodiscard]] double snap(const double value, const double lo, const double hi,
+                          const double step) {
+  return std::clamp(std::round(value / step) * step, lo, hi);
+}
+
+// Random slider interactions of one session, starting from the app's defaults:
+// range-slider drags, typed spot/tau/rate/dividend changes (a new spot resets
+// the strike window around it, as the app does) and greek switches (which
+// repeat the current surface). Each drag emits `updatesPerDrag` evenly spaced
+// intermediate requests
+[[nodiscard]] std::vector<Event> syntheticSession(const std::size_t session,
+                                                  const CliOptions& opts) {
+  std::mt19937_64 rng{opts.seed + session};
+  std::uniform_real_distribution<double> unit{0.0, 1.0};
+  std::discrete_distribution<int> pickControl{
+      // sigma, strike, greek, spot, tau, r, q
+      {30.0, 30.0, 15.0, 10.0, 5.0, 5.0, 5.0}};
+
+  Event state{.session_ = session,
+              .spot_ = 100.0,
+              .r_ = 0.05,
+              .q_ = 0.02,
+              .sigmaLo_ = 0.1,
+              .sigmaHi_ = 0.4,
+              .strikeLo_ = 100.0 * strikeValPcts[0],
+              .strikeHi_ = 100.0 * strikeValPcts[1],
+              .tau_ = 1.0};
+
+  // Moves of 1-20% of the slider's span in either direction
+  const auto move{[&](const double span) {
+    const double size{span * (0.01 + 0.19 * unit(rng))};
+    return unit(rng) < 0.5 ? -size : size;
+  }};
+
+  std::vector<Event> events{};
+  events.reserve(opts.nEvents);
+
+  while (events.size() < opts.nEvents) {
+    const Event from{state};
+
+    switch (pickControl(rng)) {
+      case 0: {  // Sigma range handle
+        const double delta{move(sigmaSlider.max_ - sigmaSlider.min_)};
+
+        if (unit(rng) < 0.5) {
+          state.sigmaLo_ = snap(state.sigmaLo_ + delta, sigmaSlider.min_,
+                                state.sigmaHi_, sigmaSlider.step_);
+        } else {
+          state.sigmaHi_ = snap(state.sigmaHi_ + delta, state.sigmaLo_,
+                                sigmaSlider.max_, sigmaSlider.step_);
+        }
+
+        break;
+      }
+
+      case 1: {  // Strike range handle (bounds are relative to spot)
+        const double lo{state.spot_ * strikeRangePcts[0]};
+        const double hi{state.spot_ * strikeRangePcts[1]};
+        const double delta{move(hi - lo)};
+
+        if (unit(rng) < 0.5) {
+          state.strikeLo_ = snap(state.strikeLo_ + delta, lo, state.strikeHi_,
+                                 strikeStep);
+        } else {
+          state.strikeHi_ = snap(state.strikeHi_ + delta, state.strikeLo_, hi,
+                                 strikeStep);
+        }
+
+        break;
+      }
+
+      case 2:  // Greek switch
+        break;
+
+      case 3: {  // Spot (relative moves; the span of the input is huge)
+        state.spot_ = snap(state.spot_ * (1.0 + move(0.1)), spotInput.min_,
+                           spotInput.max_, spotInput.step_);
+        state.strikeLo_ = snap(state.spot_ * strikeValPcts[0], 0.0,
+                               spotInput.max_, strikeStep);
+        state.strikeHi_ = snap(state.spot_ * strikeValPcts[1], 0.0,
+                               spotInput.max_, strikeStep);
+        break;
+      }
+
+      case 4:
+        state.tau_ = snap(state.tau_ + move(tauInput.max_ - tauInput.min_),
+                          tauInput.min_, tauInput.max_, tauInput.step_);
+        break;
+
+      case 5:
+        state.r_ = snap(state.r_ + move(rateInput.max_ - rateInput.min_),
+                        rateInput.min_, rateInput.max_, rateInput.step_);
+        break;
+
+      default:
+        state.q_ = snap(state.q_ + move(divInput.max_ - divInput.min_),
+                        divInput.min_, divInput.max_, divInput.step_);
+        break;
+    }
+
+    // Intermediate positions of the drag (only range sliders report them)
+    const bool isDrag{state.sigmaLo_ != from.sigmaLo_ ||
+                      state.sigmaHi_ != from.sigmaHi_ ||
+                      (state.spot_ == from.spot_ &&
+                       (state.strikeLo_ != from.strikeLo_ ||
+                        state.strikeHi_ != from.strikeHi_))};
+    const std::size_t nUpdates{isDrag ? opts.updatesPerDrag : 1};
+
+    for (std::size_t step{1};
+         step < nUpdates && events.size() + 1 < opts.nEvents; ++step) {
+      const double t{static_cast<double>(step) /
+                     static_cast<double>(nUpdates)};
+      const auto along{[t](const double lo, const double hi,
+                           const double increment) {
+        return snap(lo + t * (hi - lo), 0.0, spotInput.max_, increment);
+      }};
+      Event partial{state};
+      partial.sigmaLo_ =
+          along(from.sigmaLo_, state.sigmaLo_, sigmaSlider.step_);
+      partial.sigmaHi_ =
+          along(from.sigmaHi_, state.sigmaHi_, sigmaSlider.step_);
+      partial.strikeLo_ = along(from.strikeLo_, state.strikeLo_, strikeStep);
+      partial.strikeHi_ = along(from.strikeHi_, state.strikeHi_, strikeStep);
+      events.push_back(partial);
+    }
+
+    events.push_back(state);
+  }
+
+  return events;
+}
+
+// --- Replay
+
+struct Sample {
+  double seconds_;
+  bool hit_;
+};
+
+// Replay every session on its own thread (a session's requests are sequential,
+// like a browser tab waiting on its heatmap callback); latencies include the
+// time spent waiting for the manager
+[[nodiscard]] std::vector<Sample> replay(
+    OptionsManager& manager,
+    const std::map<std::size_t, std::vector<Event>>& sessions,
+    const CliOptions& opts) {
+  using Clock = std::chrono::steady_clock;
+  std::mutex managerMutex{};
+  std::mutex samplesMutex{};
+  std::vector<Sample> samples{};
+  std::exception_ptr failure{nullptr};
+
+  {
+    std::vector<std::jthread> drivers{};
+    drivers.reserve(sessions.size());
+
+    for (const auto& session : sessions) {
+      drivers.emplace_back([&, &events = session.second] {
+        std::vector<Sample> local{};
+        local.reserve(events.size());
+
+        try {
+          for (const Event& e : events) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds{opts.thinkMs});
+            const auto start{Clock::now()};
+            const std::lock_guard lock{managerMutex};
+            const std::uint64_t hitsBefore{manager.cacheStats().hits_};
+            static_cast<void>(manager.get(opts.resolution, opts.resolution,
+                                          e.spot_, e.r_, e.q_, e.sigmaLo_,
+                                          e.sigmaHi_, e.strikeLo_,
+                                          e.strikeHi_, e.tau_));
+            const std::chrono::duration<double> elapsed{Clock::now() - start};
+            local.push_back(
+                Sample{.seconds_ = elapsed.count(),
+                       .hit_ = manager.cacheStats().hits_ > hitsBefore});
+          }
+        } catch (...) {
+          const std::lock_guard lock{samplesMutex};
+
+          if (!failure) {
+            failure = std::current_exception();
+          }
+        }
+
+        const std::lock_guard lock{samplesMutex};
+        samples.insert(samples.end(), local.cbegin(), local.cend());
+      });
+    }
+  }  // join drivers
+
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+
+  return samples;
+}
+
+// --- Report
+
+// Nearest-rank percentile of sorted values
+[[nodiscard]] double percentile(const std::vector<double>& sorted,
+                                const double pct) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+
+  const auto rank{static_cast<std::size_t>(
+      std::ceil(pct / 100.0 * static_cast<double>(sorted.size())))};
+  return sorted[std::clamp(rank, std::size_t{1}, sorted.size()) - 1];
+}
+
+void printLatencies(const std::string_view label,
+                    const std::vector<Sample>& samples,
+                    const std::optional<bool> hits) {
+  std::vector<double> ms{};
+
+  for (const Sample& sample : samples) {
+    if (!hits || sample.hit_ == *hits) {
+      ms.push_back(sample.seconds_ * 1e3);
+    }
+  }
+
+  std::sort(ms.begin(), ms.end());
+  std::cout << "  " << std::left << std::setw(8) << label << std::right
+            << std::setw(8) << ms.size();
+
+  for (const double pct : {50.0, 90.0, 99.0, 100.0}) {
+    std::cout << std::setw(11) << percentile(ms, pct);
+  }
+
+  std::cout << '\n';
+}
+
+// Peak resident set size of this process in MiB (ru_maxrss is in KiB on Linux)
+[[nodiscard]] double peakRssMiB() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CliOptions opts{};
+
+  try {
+    opts = parseArgs(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    std::vector<Event> events{};
+
+    if (opts.trace.empty()) {
+      for (std::size_t session{0}; session < opts.nSessions; ++session) {
+        std::vector<Event> synthetic{syntheticSession(session, opts)};
+        events.insert(events.end(), synthetic.cbegin(), synthetic.cend());
+      }
+
+      if (!opts.save.empty()) {
+        writeTrace(opts.save, events);
+      }
+    } else {
+      events = readTrace(opts.trace);
+    }
+
+    std::map<std::size_t, std::vector<Event>> sessions{};
+
+    for (const Event& event : events) {
+      sessions[event.session_].push_back(event);
+    }
+
+    OptionsManager manager{ManagerConfig{
+        .capacity_ = opts.capacity,
+        .nThreads_ = opts.nThreads,
+        .cachePolicy_ = opts.cachePolicy,
+        .tree_ = {.depth_ = opts.treeDepth},
+        .coldCapacity_ = opts.coldCapacity}};
+
+    const auto start{std::chrono::steady_clock::now()};
+    const std::vector<Sample> samples{replay(manager, sessions, opts)};
+    const std::chrono::duration<double> wall{std::chrono::steady_clock::now() -
+                                             start};
+    const CacheStats stats{manager.cacheStats()};
+
+    std::cout << std::fixed << std::setprecision(3) << "Sessions "
+              << sessions.size() << ", requests " << samples.size() << " in "
+              << wall.count() << " s ("
+              << static_cast<double>(samples.size()) / wall.count()
+              << " requests/s)\n"
+              << "Cache hit rate " << std::setprecision(1)
+              << 100.0 * stats.hitRate() << "% (hits " << stats.hits_
+              << ", misses " << stats.misses_ << ", cold hits "
+              << stats.coldHits_ << ", evictions " << stats.evictions_
+              << ", rejections " << stats.rejections_ << ")\n"
+              << std::setprecision(3) << "Latency (ms)   count        p50"
+              << "        p90        p99        max\n";
+    printLatencies("all", samples, std::nullopt);
+    printLatencies("hits", samples, true);
+    printLatencies("misses", samples, false);
+    std::cout << "Peak RSS " << std::setprecision(1) << peakRssMiB()
+              << " MiB\n";
+  } catch (const std::exception& e) {
+    std::cerr << "Replay failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+#include "OptionsVisualizer/batch/BatchReader.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+
+namespace {
+
+// Convert a whole (trimmed) field of a batch line
+template <typename T>
+[[nodiscard]] T convert(const std::string_view field, const std::size_t idx,
+                        const std::size_t lineNo) {
+  T value{};
+  const auto [ptr, ec]{
+      std::from_chars(field.data(), field.data() + field.size(), value)};
+
+  if (ec != std::errc{} || ptr != field.data() + field.size()) {
+    throw std::runtime_error{"Conversion error in field " +
+                             std::to_string(idx) + " on line " +
+                             std::to_string(lineNo)};
+  }
+
+  return value;
+}
+
+}  // namespace
+
+namespace batch {
+
+BatchReader::BatchReader(const std::string& path) : in_{path} {
+  if (!in_.is_open()) {
+    throw std::runtime_error{"Unable to open batch input file: " + path};
+  }
+}
+
+std::optional<BatchJob> BatchReader::next() {
+  const std::lock_guard lock{mutex_};
+
+  while (std::getline(in_, line_)) {
+    ++lineNo_;
+
+    if (!line_.empty() && line_.back() == '\r') {
+      line_.pop_back();
+    }
+
+    // Skip blank lines and comments
+    if (line_.empty() || line_.front() == '#') {
+      continue;
+    }
+
+    BatchJob job{parseLine()};
+    job.index_ = nJobs_++;
+    return job;
+  }
+
+  return std::nullopt;
+}
+
+BatchJob BatchReader::parseLine() const {
+  static constexpr std::size_t nSurfaceFields{10};
+  static constexpr std::size_t nContractFields{6};
+  std::array<std::string_view, nSurfaceFields> tokens{};
+  std::size_t nFields{0};
+
+  const std::string_view view{line_};
+  std::size_t lPtr{0};
+
+  while (lPtr <= view.size()) {
+    const std::size_t rPtr{std::min(view.find(',', lPtr), view.size())};
+
+    if (nFields == nSurfaceFields) {
+      throw std::runtime_error{"Too many fields on line " +
+                               std::to_string(lineNo_)};
+    }
+
+    // Trim surrounding whitespace
+    std::string_view sub{view.substr(lPtr, rPtr - lPtr)};
+    sub.remove_prefix(std::min(sub.find_first_not_of(' '), sub.size()));
+    sub.remove_suffix(sub.size() - (sub.find_last_not_of(' ') + 1));
+    tokens[nFields++] = sub;
+    lPtr = rPtr + 1;
+  }
+
+  const auto number{[&](const std::size_t idx) {
+    return convert<double>(tokens[idx], idx, lineNo_);
+  }};
+
+  // Grid sizes are parsed as integers so fractional, non-finite or
+  // out-of-range sizes are rejected rather than truncated
+  const auto count{[&](const std::size_t idx) {
+    return convert<Eigen::Index>(tokens[idx], idx, lineNo_);
+  }};
+
+  BatchJob job{};
+
+  if (nFields == nSurfaceFields) {
+    job.nSigma_ = count(0);
+    job.nStrike_ = count(1);
+    job.spot_ = number(2);
+    job.r_ = number(3);
+    job.q_ = number(4);
+    job.sigmaLo_ = number(5);
+    job.sigmaHi_ = number(6);
+    job.strikeLo_ = number(7);
+    job.strikeHi_ = number(8);
+    job.tau_ = number(9);
+  } else if (nFields == nContractFields) {
+    job.spot_ = number(0);
+    job.strikeLo_ = number(1);
+    job.strikeHi_ = job.strikeLo_;
+    job.r_ = number(2);
+    job.q_ = number(3);
+    job.sigmaLo_ = number(4);
+    job.sigmaHi_ = job.sigmaLo_;
+    job.tau_ = number(5);
+  } else {
+    throw std::runtime_error{"Expected " + std::to_string(nSurfaceFields) +
+                             " or " + std::to_string(nContractFields) +
+                             " fields on line " + std::to_string(lineNo_)};
+  }
+
+  // Reject parameter sets the pricing models can't handle
+  const auto finite{[](const auto... values) {
+    return (std::isfinite(values) && ...);
+  }};
+
+  if (job.nSigma_ < 1 || job.nStrike_ < 1 ||
+      !finite(job.spot_, job.r_, job.q_, job.sigmaLo_, job.sigmaHi_,
+              job.strikeLo_, job.strikeHi_, job.tau_) ||
+      job.spot_ <= 0.0 || job.sigmaLo_ <= 0.0 || job.sigmaHi_ <= 0.0 ||
+      job.strikeLo_ <= 0.0 || job.strikeHi_ <= 0.0 || job.tau_ <= 0.0) {
+    throw std::runtime_error{"Invalid pricing parameters on line " +
+                             std::to_string(lineNo_)};
+  }
+
+  return job;
+}
+
+}  // namespace batch
@@ -0,0 +1,74 @@
+#include "OptionsVisualizer/batch/BatchWriter.hpp"
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+#include "OptionsVisualizer/core/Enums.hpp"
+
+namespace batch {
+
+BatchWriter::BatchWriter(const std::string& path, const ValueFormat format)
+    : out_{path, std::ios::binary | std::ios::trunc}, format_{format} {
+  if (!out_.is_open()) {
+    throw std::runtime_error{"Unable to open batch output file: " + path};
+  }
+
+  // File header
+  static constexpr std::uint32_t version{1};
+  out_.write("OVPB", 4);
+  writeRaw(version);
+  writeRaw(static_cast<std::uint8_t>(
+      format_ == ValueFormat::Float64 ? sizeof(double) : sizeof(float)));
+  writeRaw(static_cast<std::uint8_t>(Enums::idx(Enums::OptionType::COUNT)));
+  writeRaw(static_cast<std::uint8_t>(Enums::idx(Enums::GreekType::COUNT)));
+  out_.flush();
+}
+
+void BatchWriter::write(const BatchJob& job, const GridArray& grids) {
+  // Convert outside of the lock so only file I/O is serialized
+  std::array<Eigen::ArrayXXf, globals::nGrids> singles{};
+
+  if (format_ == ValueFormat::Float32) {
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      singles[idx] = grids[idx].cast<float>();
+    }
+  }
+
+  const std::lock_guard lock{mutex_};
+
+  // Record header
+  writeRaw(job.index_);
+  writeRaw(static_cast<std::int64_t>(job.nSigma_));
+  writeRaw(static_cast<std::int64_t>(job.nStrike_));
+
+  for (const double param : {job.spot_, job.r_, job.q_, job.sigmaLo_,
+                             job.sigmaHi_, job.strikeLo_, job.strikeHi_,
+                             job.tau_}) {
+    writeRaw(param);
+  }
+
+  // Grid values (Eigen storage is column-major and contiguous)
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    if (format_ == ValueFormat::Float64) {
+      out_.write(reinterpret_cast<const char*>(grids[idx].data()),
+                 static_cast<std::streamsize>(grids[idx].size() *
+                                              Eigen::Index{sizeof(double)}));
+    } else {
+      out_.write(reinterpret_cast<const char*>(singles[idx].data()),
+                 static_cast<std::streamsize>(singles[idx].size() *
+                                              Eigen::Index{sizeof(float)}));
+    }
+  }
+
+  out_.flush();
+
+  if (!out_) {
+    throw std::runtime_error{"Failed to write batch results"};
+  }
+}
+
+}  // namespace batch
@@ -0,0 +1,59 @@
+#include "OptionsVisualizer/core/GridBlock.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "OptionsVisualizer/core/globals.hpp"
+
+void GridBlock::Free::operator()(double* const ptr) const noexcept {
+  ::operator delete[](ptr, std::align_val_t{alignment});
+}
+
+GridBlock::GridBlock() noexcept
+    : nSigma_{0}, nStrike_{0}, gridStride_{0}, data_{} {}
+
+GridBlock::GridBlock(const Eigen::Index nSigma, const Eigen::Index nStrike)
+    : nSigma_{nSigma},
+      nStrike_{nStrike},
+      gridStride_{stride(nSigma, nStrike)},
+      data_{static_cast<double*>(::operator new[](
+          std::max(size(), std::size_t{1}) * sizeof(double),
+          std::align_val_t{alignment}))} {}
+
+GridBlock::GridBlock(const GridBlock& other)
+    : GridBlock{other.nSigma_, other.nStrike_} {
+  std::copy_n(other.data_.get(), size(), data_.get());
+}
+
+GridBlock& GridBlock::operator=(const GridBlock& other) {
+  if (this != &other) {
+    GridBlock copy{other};
+    *this = std::move(copy);
+  }
+
+  return *this;
+}
+
+GridBlock::GridBlock(GridBlock&& other) noexcept
+    : nSigma_{std::exchange(other.nSigma_, 0)},
+      nStrike_{std::exchange(other.nStrike_, 0)},
+      gridStride_{std::exchange(other.gridStride_, 0)},
+      data_{std::move(other.data_)} {}
+
+GridBlock& GridBlock::operator=(GridBlock&& other) noexcept {
+  nSigma_ = std::exchange(other.nSigma_, 0);
+  nStrike_ = std::exchange(other.nStrike_, 0);
+  gridStride_ = std::exchange(other.gridStride_, 0);
+  data_ = std::move(other.data_);
+  return *this;
+}
+
+Eigen::Index GridBlock::stride(const Eigen::Index nSigma,
+                               const Eigen::Index nStrike) noexcept {
+  constexpr auto perLine{
+      static_cast<Eigen::Index>(alignment / sizeof(double))};
+  return (nSigma * nStrike + perLine - 1) / perLine * perLine;
+}
@@ -4,40 +4,713 @@
 #include <Eigen/Dense>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <future>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/Topology.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/ipc/SharedCache.hpp"
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+#include "OptionsVisualizer/lru/CompressedGrids.hpp"
 #include "OptionsVisualizer/lru/LRUCache.hpp"
+#include "OptionsVisualizer/lru/SurfaceCache.hpp"
 #include "OptionsVisualizer/pricing/PricingParams.hpp"
-#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/ProgressiveSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceBatch.hpp"
+#include "OptionsVisualizer/pricing/SurfaceQueue.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+#include "OptionsVisualizer/pricing/TermStructure.hpp"
+
+namespace {
+
+// Tree settings with the number of partitions resolved (0 -> one per NUMA
+// node)
+[[nodiscard]] models::trinomial::TreeSettings resolvePartitions(
+    models::trinomial::TreeSettings tree,
+    const std::vector<std::vector<int>>& nodes) {
+  if (tree.partitions_ == 0) {
+    tree.partitions_ = static_cast<Eigen::Index>(nodes.size());
+  }
+
+  return tree;
+}
+
+// Build one view per grid of a block
+[[nodiscard]] OptionsManager::GridViews makeViews(const GridBlock::View& view) {
+  return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+    return OptionsManager::GridViews{view.grid(Idx)...};
+  }(std::make_index_sequence<globals::nGrids>{});
+}
+
+}  // namespace
 
 // Constructs a thread pool with number of threads available on hardware
 OptionsManager::OptionsManager(const std::size_t capacity)
-    : lru_{std::max(capacity, std::size_t{1})}, pool_{} {}
+    : OptionsManager{ManagerConfig{.capacity_ = capacity}} {}
 
 // Constructs a thread pool with specified number of threads
 OptionsManager::OptionsManager(const std::size_t capacity,
                                const std::size_t nThreads)
-    : lru_{std::max(capacity, std::size_t{1})},
-      pool_{std::max(nThreads, std::size_t{1})} {}
+    : OptionsManager{
+          ManagerConfig{.capacity_ = capacity,
+                        .nThreads_ = std::max(nThreads, std::size_t{1})}} {}
+
+// Constructs from a full configuration (optionally attaching to, or creating, a
+// host-wide shared-memory cache)
+OptionsManager::OptionsManager(const ManagerConfig& config)
+    : OptionsManager{config, Utils::numaNodes()} {}
+
+OptionsManager::OptionsManager(const ManagerConfig& config,
+                               const std::vector<std::vector<int>>& nodes)
+    : mutex_{},
+      cache_{std::max(config.capacity_, std::size_t{1}), config.cachePolicy_},
+      cold_{std::max(config.coldCapacity_, std::size_t{1})},
+      coldTolerance_{config.coldTolerance_},
+      tree_{resolvePartitions(config.tree_, nodes)},
+      shared_{},
+      mapped_{std::max(config.capacity_, std::size_t{1})},
+      refining_{},
+      previewStride_{config.previewStride_},
+      previewDepth_{config.previewDepth_},
+      submitted_{},
+      batches_{},
+      coalesceMs_{config.coalesceMs_},
+      warming_{},
+      stopWarmup_{std::make_shared<std::atomic<bool>>(false)},
+      pool_{config.nThreads_ == 0
+                ? std::max(std::size_t{std::thread::hardware_concurrency()},
+                           std::size_t{1})
+                : config.nThreads_,
+            // Threads are pinned before they run (and allocate) anything;
+            // pinning is best effort
+            [affinity = config.affinity_, nodes](const std::size_t idx) {
+              static_cast<void>(
+                  Utils::pinThread(Utils::threadCpus(affinity, nodes, idx)));
+            }},
+      queue_{pool_, tree_, pool_.get_thread_count()} {
+  if (!config.sharedCache_.empty()) {
+    shared_.emplace(config.sharedCache_,
+                    std::max(config.sharedCapacity_, std::size_t{1}), tree_);
+  }
+
+  // Compress entries on their way out of the cache
+  if (config.coldCapacity_ > 0) {
+    cache_.setEvictionHandler([this](const PricingParams& params,
+                                     GridArray&& grids, const double cost) {
+      cold_.erase(params);
+      cold_.set(params, ColdEntry{.grids_ = CompressedGrids{grids,
+                                                            coldTolerance_},
+                                  .cost_ = cost});
+    });
+  }
+
+  // Warm the cache in the background (surfaces another process already
+  // published are skipped)
+  std::vector<SurfaceSpec> warmup{};
+
+  for (const SurfaceSpec& surface : config.warmup_) {
+    PricingParams params{surface.sigmas_, surface.strikes_, surface.spot_,
+                         surface.r_,      surface.q_,       surface.tau_};
+
+    if (shared_ && shared_->find(params)) {
+      continue;
+    }
+
+    warming_.emplace_back(std::move(params), nullptr);
+    warmup.push_back(surface);
+  }
+
+  if (!warmup.empty()) {
+    const std::vector<std::shared_ptr<SurfaceTask>> tasks{
+        SurfaceTask::startSequence(std::move(warmup), pool_, tree_,
+                                   BS::pr::lowest, stopWarmup_)};
+
+    for (std::size_t idx{0}; idx < tasks.size(); ++idx) {
+      warming_[idx].second = tasks[idx];
+    }
+  }
+}
+
+OptionsManager::~OptionsManager() {
+  for (auto& [_, refinement] : refining_) {
+    refinement.surface_->supersede();
+  }
+
+  for (auto& [_, refinement] : refining_) {
+    refinement.done_.wait();
+  }
+
+  for (const auto& [_, task] : submitted_) {
+    task->wait();
+  }
+
+  stopWarmup_->store(true);
+
+  for (const auto& [_, task] : warming_) {
+    task->wait();
+  }
+}
 
 // Retrieve cached greek values or compute new ones and cache the results
 const OptionsManager::GridArray& OptionsManager::get(
     const Eigen::Index nSigma, const Eigen::Index nStrike, const double spot,
     const double r, const double q, const double sigmaLo, const double sigmaHi,
     const double strikeLo, const double strikeHi, const double tau) {
-  // Can't pass these directly to PricingSurface ctor since doubles get
-  // quantized to integers
-  const PricingParams params{nSigma,  nStrike, spot,     r,        q,
-                             sigmaLo, sigmaHi, strikeLo, strikeHi, tau};
+  return get(linspace(nSigma, sigmaLo, sigmaHi),
+             linspace(nStrike, strikeLo, strikeHi), spot, r, q, tau);
+}
+
+// Retrieve cached greek values over explicit axes
+const OptionsManager::GridArray& OptionsManager::get(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q, const double tau) {
+  std::unique_lock lock{mutex_};
+  return get(PricingParams{sigmas, strikes, spot, r, q, tau},
+             SurfaceSpec{.sigmas_ = sigmas,
+                         .strikes_ = strikes,
+                         .spot_ = spot,
+                         .r_ = r,
+                         .q_ = q,
+                         .tau_ = tau},
+             lock);
+}
+
+// Retrieve views of cached greek values (mapped straight from shared memory
+// when a shared cache is in use)
+OptionsManager::GridViews OptionsManager::getViews(
+    const Eigen::Index nSigma, const Eigen::Index nStrike, const double spot,
+    const double r, const double q, const double sigmaLo, const double sigmaHi,
+    const double strikeLo, const double strikeHi, const double tau) {
+  return getViews(linspace(nSigma, sigmaLo, sigmaHi),
+                  linspace(nStrike, strikeLo, strikeHi), spot, r, q, tau);
+}
+
+// Retrieve views of cached greek values over explicit axes
+OptionsManager::GridViews OptionsManager::getViews(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q, const double tau) {
+  return makeViews(getBlock(sigmas, strikes, spot, r, q, tau));
+}
+
+// Retrieve a view of the whole block of cached greek values
+GridBlock::View OptionsManager::getBlock(
+    const Eigen::Index nSigma, const Eigen::Index nStrike, const double spot,
+    const double r, const double q, const double sigmaLo, const double sigmaHi,
+    const double strikeLo, const double strikeHi, const double tau) {
+  return getBlock(linspace(nSigma, sigmaLo, sigmaHi),
+                  linspace(nStrike, strikeLo, strikeHi), spot, r, q, tau);
+}
+
+// Retrieve a view of the whole block of cached greek values over explicit axes
+// (mapped straight from shared memory when a shared cache is in use)
+GridBlock::View OptionsManager::getBlock(const Eigen::ArrayXd& sigmas,
+                                         const Eigen::ArrayXd& strikes,
+                                         const double spot, const double r,
+                                         const double q, const double tau) {
+  std::unique_lock lock{mutex_};
+  const PricingParams params{sigmas, strikes, spot, r, q, tau};
+  const SurfaceSpec surface{.sigmas_ = sigmas,
+                            .strikes_ = strikes,
+                            .spot_ = spot,
+                            .r_ = r,
+                            .q_ = q,
+                            .tau_ = tau};
+
+  if (!shared_) {
+    return get(params, surface, lock).view();
+  }
+
+  collectWarmup();
+  awaitPending(params, lock);
+
+  if (!mapped_.contains(params)) {
+    std::optional<ipc::SharedGrids> segment{shared_->find(params)};
+
+    // Nobody has published these parameters yet (publishing returns the
+    // existing segment if someone did while the lock was released)
+    if (!segment) {
+      const std::shared_ptr<SurfaceTask> task{
+          priceUnlocked(params, surface, lock)};
+      segment.emplace(shared_->publish(params, *task->grids()));
+    }
+
+    // Another call may have mapped it while the lock was released
+    if (!mapped_.contains(params)) {
+      mapped_.set(params, std::move(*segment));
+    }
+  }
+
+  return mapped_.get(params).view();
+}
+
+// Retrieve greek values at several maturities
+std::vector<OptionsManager::GridArray> OptionsManager::getCube(
+    const Eigen::Index nSigma, const Eigen::Index nStrike, const double spot,
+    const double r, const double q, const double sigmaLo, const double sigmaHi,
+    const double strikeLo, const double strikeHi, const Eigen::ArrayXd& taus) {
+  return getCube(linspace(nSigma, sigmaLo, sigmaHi),
+                 linspace(nStrike, strikeLo, strikeHi), spot, r, q, taus);
+}
+
+// Retrieve greek values at several maturities over explicit axes (pricing the
+// maturities that aren't cached together)
+std::vector<OptionsManager::GridArray> OptionsManager::getCube(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q,
+    const Eigen::ArrayXd& taus) {
+  std::unique_lock lock{mutex_};
+  collectWarmup();
+  std::vector<GridArray> cube(static_cast<std::size_t>(taus.size()));
+
+  // Maturities that still have to be priced (their position in the cube and
+  // their cache keys)
+  std::vector<std::size_t> missing{};
+  std::vector<PricingParams> missingParams{};
+
+  for (std::size_t idx{0}; idx < cube.size(); ++idx) {
+    const double tau{taus[static_cast<Eigen::Index>(idx)]};
+    PricingParams params{sigmas, strikes, spot, r, q, tau};
+    awaitPending(params, lock);
+
+    // Blocks are copied right away since caching later maturities may evict
+    // earlier ones
+    if (const GridArray* const cached{findCached(params)}) {
+      cube[idx] = *cached;
+      continue;
+    }
+
+    if (shared_) {
+      if (const std::optional<ipc::SharedGrids> segment{
+              shared_->find(params)}) {
+        cube[idx] = cache_.set(params, segment->toGrids(), 0.0);
+        continue;
+      }
+    }
+
+    missing.push_back(idx);
+    missingParams.push_back(std::move(params));
+  }
+
+  if (missing.empty()) {
+    return cube;
+  }
+
+  Eigen::ArrayXd missingTaus(static_cast<Eigen::Index>(missing.size()));
+
+  for (std::size_t idx{0}; idx < missing.size(); ++idx) {
+    missingTaus[static_cast<Eigen::Index>(idx)] =
+        taus[static_cast<Eigen::Index>(missing[idx])];
+  }
+
+  // Other calls go ahead while the missing maturities are priced
+  lock.unlock();
+  const auto start{std::chrono::steady_clock::now()};
+  std::vector<GridArray> priced{
+      TermStructure{sigmas, strikes, spot, r, q, missingTaus, pool_, tree_}
+          .calculateGrids()};
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                              start};
+  lock.lock();
+
+  // Each maturity is charged an equal share of the pricing time
+  const double cost{elapsed.count() / static_cast<double>(missing.size())};
+
+  for (std::size_t idx{0}; idx < missing.size(); ++idx) {
+    store(missingParams[idx], priced[idx], cost);
+    cube[missing[idx]] = std::move(priced[idx]);
+  }
+
+  return cube;
+}
+
+// Book P&L and greek totals over a shock grid
+Portfolio::Scenarios OptionsManager::revalue(
+    const std::vector<Portfolio::Position>& positions, const double spot,
+    const double r, const double q, const double sigma,
+    const Eigen::ArrayXd& spotShocks, const Eigen::ArrayXd& volShocks) {
+  return Portfolio{positions, spot, r, q, sigma, pool_, tree_}.revalue(
+      spotShocks, volShocks);
+}
+
+// Latest refinement stage of a surface (starting the refinement if needed)
+OptionsManager::Progress OptionsManager::getProgressive(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q, const double tau) {
+  using Stage = ProgressiveSurface::Stage;
+  std::unique_lock lock{mutex_};
+  collectRefinements();
+  collectSubmissions();
+  collectWarmup();
+  const PricingParams params{sigmas, strikes, spot, r, q, tau};
+
+  // Already being priced in full by a submission
+  if (submitted_.contains(params)) {
+    return Progress{.stage_ = Stage::Pending, .grids_ = nullptr, .owner_ = {}};
+  }
+
+  // Same for a warm-up surface that has started (one that hasn't is refined
+  // instead)
+  if (const auto it{findWarming(params)}; it != warming_.end()) {
+    if (!it->second->cancel()) {
+      return Progress{
+          .stage_ = Stage::Pending, .grids_ = nullptr, .owner_ = {}};
+    }
+
+    warming_.erase(it);
+  }
+
+  if (const auto it{refining_.find(params)}; it != refining_.end()) {
+    // Still being polled, so it's no longer superseded (if it already stopped
+    // early it's dropped on the next call and started over)
+    it->second.surface_->resume();
+    ProgressiveSurface::Snapshot snapshot{it->second.surface_->latest()};
+
+    if (snapshot.stage_ != Stage::Final) {
+      const GridArray* const grids{snapshot.grids_.get()};
+      return Progress{.stage_ = snapshot.stage_,
+                      .grids_ = grids,
+                      .owner_ = std::move(snapshot.grids_)};
+    }
+
+    // Finished since the refinements were collected
+    const std::shared_future<void> done{it->second.done_};
+    lock.unlock();
+    done.wait();
+    lock.lock();
+    collectRefinements();
+  }
+
+  if (const GridArray* const cached{findCached(params)}) {
+    return Progress{.stage_ = Stage::Final, .grids_ = cached, .owner_ = {}};
+  }
+
+  if (shared_) {
+    if (const std::optional<ipc::SharedGrids> segment{shared_->find(params)}) {
+      const GridArray& grids{cache_.set(params, segment->toGrids(), 0.0)};
+      return Progress{.stage_ = Stage::Final, .grids_ = &grids, .owner_ = {}};
+    }
+  }
+
+  // Refinements of earlier requests stop after their current stage so the
+  // pool moves on to this one (e.g. while a slider is being dragged)
+  for (auto& [_, refinement] : refining_) {
+    refinement.surface_->supersede();
+  }
+
+  // The refinement runs on its own thread since it waits on tasks it submits
+  // to the pool
+  auto surface{std::make_shared<ProgressiveSurface>(
+      sigmas, strikes, spot, r, q, tau, pool_, tree_, previewStride_,
+      previewDepth_)};
+  std::shared_future<void> done{
+      std::async(std::launch::async, [surface] { surface->run(); })};
+  refining_.emplace(params, Refinement{.surface_ = std::move(surface),
+                                       .done_ = std::move(done)});
+  return Progress{.stage_ = Stage::Pending, .grids_ = nullptr, .owner_ = {}};
+}
+
+// Start pricing a surface in the background (or share the task pricing it)
+std::shared_ptr<SurfaceTask> OptionsManager::submit(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q, const double tau) {
+  const std::lock_guard lock{mutex_};
+  collectRefinements();
+  collectSubmissions();
+  collectWarmup();
+  const PricingParams params{sigmas, strikes, spot, r, q, tau};
+
+  if (const auto it{submitted_.find(params)}; it != submitted_.end()) {
+    return it->second;
+  }
+
+  // Cached surfaces are copied into the task so its grids don't depend on the
+  // cache
+  if (const GridArray* const cached{findCached(params)}) {
+    return std::make_shared<SurfaceTask>(*cached);
+  }
+
+  if (shared_) {
+    if (const std::optional<ipc::SharedGrids> segment{shared_->find(params)}) {
+      const GridArray& grids{cache_.set(params, segment->toGrids(), 0.0)};
+      return std::make_shared<SurfaceTask>(grids);
+    }
+  }
+
+  std::shared_ptr<SurfaceTask> task{};
+
+  if (coalesceMs_ > 0.0) {
+    // Batches that stopped accepting surfaces are finished by their own thread
+    std::erase_if(batches_, [](const std::shared_ptr<SurfaceBatch>& batch) {
+      return batch->closed();
+    });
+
+    const auto it{std::ranges::find_if(
+        batches_, [&](const std::shared_ptr<SurfaceBatch>& batch) {
+          return batch->matches(spot, r, q, tau);
+        })};
+
+    if (it != batches_.end()) {
+      task = (*it)->join(sigmas, strikes);
+    }
+
+    // No open batch (or it closed in the meantime)
+    if (!task) {
+      const auto window{std::chrono::duration<double, std::milli>{coalesceMs_}};
+      task = batches_
+                 .emplace_back(std::make_shared<SurfaceBatch>(
+                     spot, r, q, tau, window, pool_, tree_))
+                 ->join(sigmas, strikes);
+    }
+  } else {
+    task = queue_.push(SurfaceSpec{.sigmas_ = sigmas,
+                                   .strikes_ = strikes,
+                                   .spot_ = spot,
+                                   .r_ = r,
+                                   .q_ = q,
+                                   .tau_ = tau});
+  }
+
+  submitted_.emplace(params, task);
+  return task;
+}
+
+// Hit/miss counters of the in-process cache
+CacheStats OptionsManager::cacheStats() const {
+  const std::lock_guard lock{mutex_};
+  return cache_.stats();
+}
+
+void OptionsManager::resetCacheStats() {
+  const std::lock_guard lock{mutex_};
+  cache_.resetStats();
+}
+
+// Whether any warm-up surface is still being priced
+bool OptionsManager::warmingUp() const {
+  const std::lock_guard lock{mutex_};
+  return std::ranges::any_of(warming_, [](const auto& entry) {
+    return !entry.second->done();
+  });
+}
+
+// Retrieve cached greek values or price and cache them (lock held)
+const OptionsManager::GridArray& OptionsManager::get(
+    const PricingParams& params, const SurfaceSpec& surface,
+    std::unique_lock<std::mutex>& lock) {
+  collectWarmup();
+  awaitPending(params, lock);
+
+  if (const GridArray* const cached{findCached(params)}) {
+    return *cached;
+  }
+
+  if (shared_) {
+    if (const std::optional<ipc::SharedGrids> segment{shared_->find(params)}) {
+      return cache_.set(params, segment->toGrids(), 0.0);
+    }
+  }
+
+  // The task's pricing wall time lets the cache weigh what it would cost to
+  // recompute
+  const std::shared_ptr<SurfaceTask> task{priceUnlocked(params, surface, lock)};
+  return store(params, *task->grids(), task->seconds());
+}
+
+// Finish a background refinement, submission or warm-up of the same parameters
+// (another one may start while the lock is released, so this repeats until none
+// is left)
+void OptionsManager::awaitPending(const PricingParams& params,
+                                  std::unique_lock<std::mutex>& lock) {
+  while (true) {
+    if (const auto it{refining_.find(params)}; it != refining_.end()) {
+      it->second.surface_->resume();
+      const std::shared_future<void> done{it->second.done_};
+      lock.unlock();
+      done.wait();
+      lock.lock();
+      collectRefinements();
+      continue;
+    }
+
+    if (const auto it{submitted_.find(params)}; it != submitted_.end()) {
+      const std::shared_ptr<SurfaceTask> task{it->second};
+      lock.unlock();
+      task->wait();
+      lock.lock();
+      collectSubmissions();
+      continue;
+    }
+
+    // A warm-up surface that's being priced is waited on, and one that hasn't
+    // started is taken out of the warm-up so the request prices it at normal
+    // priority
+    if (const auto it{findWarming(params)}; it != warming_.end()) {
+      const std::shared_ptr<SurfaceTask> task{it->second};
+
+      if (task->cancel()) {
+        warming_.erase(it);
+        continue;
+      }
+
+      lock.unlock();
+      task->wait();
+      lock.lock();
+      collectWarmup();
+      continue;
+    }
+
+    return;
+  }
+}
+
+// Price a surface with the lock released while identical requests wait on it
+std::shared_ptr<SurfaceTask> OptionsManager::priceUnlocked(
+    const PricingParams& params, const SurfaceSpec& surface,
+    std::unique_lock<std::mutex>& lock) {
+  auto task{std::make_shared<SurfaceTask>()};
+  submitted_.emplace(params, task);
+  lock.unlock();
+  task->price(surface, pool_, tree_, BS::pr::normal);
+  lock.lock();
+
+  // Unless another call already collected it
+  if (const auto it{submitted_.find(params)};
+      it != submitted_.end() && it->second == task) {
+    submitted_.erase(it);
+  }
+
+  static_cast<void>(task->grids());  // rethrows a failure
+  return task;
+}
+
+// Warm-up entry of a set of parameters (or the end of `warming_`)
+OptionsManager::WarmupList::iterator OptionsManager::findWarming(
+    const PricingParams& params) {
+  return std::ranges::find_if(
+      warming_, [&params](const auto& entry) { return entry.first == params; });
+}
+
+// Cached grids (promoting compressed entries from the cold tier) or null
+const OptionsManager::GridArray* OptionsManager::findCached(
+    const PricingParams& params) {
+  if (const GridArray* const cached{cache_.find(params)}) {
+    return cached;
+  }
+
+  // Promote compressed entries back into the cache
+  if (cold_.contains(params)) {
+    const ColdEntry& cold{cold_.get(params)};
+    GridArray grids{cold.grids_.decompress()};
+    const double cost{cold.cost_};
+    cold_.erase(params);
+    cache_.recordColdHit();
+    return &cache_.set(params, std::move(grids), cost);
+  }
+
+  return nullptr;
+}
+
+// Move every finished refinement into the cache (and the shared cache)
+void OptionsManager::collectRefinements() {
+  for (auto it{refining_.begin()}; it != refining_.end();) {
+    Refinement& refinement{it->second};
+
+    if (refinement.done_.wait_for(std::chrono::seconds{0}) !=
+        std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
+    // Failed refinements are dropped before rethrowing so the next call starts
+    // over
+    const PricingParams params{it->first};
+    const std::shared_future<void> done{std::move(refinement.done_)};
+    const std::shared_ptr<ProgressiveSurface> surface{
+        std::move(refinement.surface_)};
+    it = refining_.erase(it);
+    done.get();
+
+    // Superseded refinements that stopped early are dropped as well
+    if (const ProgressiveSurface::Snapshot snapshot{surface->latest()};
+        snapshot.stage_ == ProgressiveSurface::Stage::Final) {
+      store(params, *snapshot.grids_, surface->stageSeconds());
+    }
+  }
+}
+
+// Move every finished submission into the cache (and the shared cache)
+void OptionsManager::collectSubmissions() {
+  for (auto it{submitted_.begin()}; it != submitted_.end();) {
+    if (!it->second->done()) {
+      ++it;
+      continue;
+    }
+
+    // Failures were already reported through the task, so they're just dropped
+    // (the next request starts over)
+    const PricingParams params{it->first};
+    const std::shared_ptr<SurfaceTask> task{std::move(it->second)};
+    it = submitted_.erase(it);
+    std::shared_ptr<const GridArray> grids{};
+
+    try {
+      grids = task->grids();
+    } catch (...) {
+      continue;
+    }
+
+    store(params, *grids, task->seconds());
+  }
+}
+
+// Move every finished warm-up surface into the cache (and the shared cache)
+void OptionsManager::collectWarmup() {
+  for (auto it{warming_.begin()}; it != warming_.end();) {
+    if (!it->second->done()) {
+      ++it;
+      continue;
+    }
+
+    // Warm-up failures are dropped (the surface is priced on request instead)
+    const auto [params, task]{std::move(*it)};
+    it = warming_.erase(it);
+    std::shared_ptr<const GridArray> grids{};
+
+    try {
+      grids = task->grids();
+    } catch (...) {
+      continue;
+    }
+
+    store(params, *grids, task->seconds());
+  }
+}
+
+// Cache (and publish) priced grids
+const OptionsManager::GridArray& OptionsManager::store(
+    const PricingParams& params, const GridArray& grids, const double cost) {
+  // A refinement and a submission of the same surface can both finish
+  if (const GridArray* const cached{cache_.peek(params)}) {
+    return *cached;
+  }
 
-  // Compute new value if not stored
-  if (!lru_.contains(params)) {
-    const PricingSurface surface{nSigma,   nStrike, spot,    r,
-                                 q,        sigmaLo, sigmaHi, strikeLo,
-                                 strikeHi, tau,     pool_};
-    lru_.set(params, surface.calculateGrids());
+  if (shared_) {
+    // Only the publication matters here, not the mapping
+    static_cast<void>(shared_->publish(params, grids));
   }
 
-  return lru_.get(params);
+  return cache_.set(params, GridArray{grids}, cost);
 }
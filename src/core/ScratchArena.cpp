@@ -0,0 +1,74 @@
+#include "OptionsVisualizer/core/ScratchArena.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace Utils {
+
+ScratchArena& ScratchArena::local() {
+  thread_local ScratchArena arena{};
+  return arena;
+}
+
+double* ScratchArena::allocate(const std::size_t nDoubles) {
+  // Round up so every allocation starts on an aligned boundary
+  const std::size_t nBytes{((nDoubles * sizeof(double) + alignment - 1) /
+                            alignment) *
+                           alignment};
+  inUse_ += nBytes;
+  peak_ = std::max(peak_, inUse_);
+
+  if (offset_ + nBytes <= capacity_) {
+    std::byte* ptr{block_.get() + offset_};
+    offset_ += nBytes;
+    return reinterpret_cast<double*>(ptr);
+  }
+
+  // Doesn't fit in the block (only happens until the block has grown to the
+  // peak usage of a request)
+  overflow_.emplace_back(new (std::align_val_t{alignment}) std::byte[nBytes]);
+  return reinterpret_cast<double*>(overflow_.back().get());
+}
+
+void ScratchArena::consolidate() {
+  overflow_.clear();
+
+  if (peak_ > capacity_) {
+    block_.reset(new (std::align_val_t{alignment}) std::byte[peak_]);
+    capacity_ = peak_;
+  }
+
+  offset_ = 0;
+  inUse_ = 0;
+  peak_ = 0;
+}
+
+ScratchArena::Scope::Scope()
+    : arena_{ScratchArena::local()},
+      offset_{arena_.offset_},
+      inUse_{arena_.inUse_},
+      nOverflow_{arena_.overflow_.size()} {
+  ++arena_.nScopes_;
+}
+
+ScratchArena::Scope::~Scope() {
+  if (--arena_.nScopes_ == 0) {
+    arena_.consolidate();
+    return;
+  }
+
+  // Nested scope: rewind to where this scope started
+  arena_.offset_ = offset_;
+  arena_.inUse_ = inUse_;
+  arena_.overflow_.resize(nOverflow_);
+}
+
+ScratchArena::ArrayMap ScratchArena::Scope::array(const Eigen::Index rows,
+                                                  const Eigen::Index cols) {
+  return ArrayMap{arena_.allocate(static_cast<std::size_t>(rows * cols)), rows,
+                  cols};
+}
+
+}  // namespace Utils
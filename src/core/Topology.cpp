@@ -0,0 +1,160 @@
+#include "OptionsVisualizer/core/Topology.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+
+namespace {
+
+// CPUs the calling thread may run on (every hardware thread if the mask can't
+// be read)
+[[nodiscard]] std::vector<int> allowedCpus() {
+  std::vector<int> cpus{};
+  cpu_set_t set{};
+
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu{0}; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+
+  if (cpus.empty()) {
+    const auto nCpus{static_cast<int>(
+        std::max(std::thread::hardware_concurrency(), 1U))};
+
+    for (int cpu{0}; cpu < nCpus; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+// Parse a sysfs CPU list such as "0-15,32-47"
+[[nodiscard]] std::vector<int> parseCpuList(const std::string& list) {
+  std::vector<int> cpus{};
+  std::istringstream ranges{list};
+  std::string range{};
+
+  while (std::getline(ranges, range, ',')) {
+    const std::size_t dash{range.find('-')};
+
+    try {
+      const int lo{std::stoi(range.substr(0, dash))};
+      const int hi{dash == std::string::npos
+                       ? lo
+                       : std::stoi(range.substr(dash + 1))};
+
+      for (int cpu{lo}; cpu <= hi; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      // Blank or malformed entries (e.g. the trailing newline) are skipped
+    }
+  }
+
+  return cpus;
+}
+
+}  // namespace
+
+namespace Utils {
+
+std::vector<std::vector<int>> numaNodes() {
+  namespace fs = std::filesystem;
+  const std::vector<int> allowed{allowedCpus()};
+
+  // Nodes in id order, restricted to the CPUs this process may use
+  std::map<int, std::vector<int>> byId{};
+  std::error_code ec{};
+
+  for (const fs::directory_entry& entry :
+       fs::directory_iterator{"/sys/devices/system/node", ec}) {
+    const std::string name{entry.path().filename().string()};
+
+    if (!name.starts_with("node") || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(),
+                     [](const char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+
+    std::ifstream file{entry.path() / "cpulist"};
+    std::string list{};
+    std::getline(file, list);
+    std::vector<int> cpus{};
+
+    for (const int cpu : parseCpuList(list)) {
+      if (std::ranges::binary_search(allowed, cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+
+    if (!cpus.empty()) {
+      byId[std::stoi(name.substr(4))] = std::move(cpus);
+    }
+  }
+
+  std::vector<std::vector<int>> nodes{};
+
+  for (auto& [_, cpus] : byId) {
+    nodes.push_back(std::move(cpus));
+  }
+
+  if (nodes.empty()) {
+    nodes.push_back(allowed);
+  }
+
+  return nodes;
+}
+
+std::vector<int> threadCpus(const Enums::ThreadAffinity affinity,
+                            const std::vector<std::vector<int>>& nodes,
+                            const std::size_t idx) {
+  if (affinity == Enums::ThreadAffinity::Off || nodes.empty()) {
+    return {};
+  }
+
+  const std::vector<int>& node{nodes[idx % nodes.size()]};
+
+  if (affinity == Enums::ThreadAffinity::Node) {
+    return node;
+  }
+
+  // Threads beyond the node's CPUs wrap around onto them
+  return {node[(idx / nodes.size()) % node.size()]};
+}
+
+bool pinThread(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return true;
+  }
+
+  cpu_set_t set{};
+  CPU_ZERO(&set);
+
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(static_cast<std::size_t>(cpu), &set);
+    }
+  }
+
+  return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+}
+
+}  // namespace Utils
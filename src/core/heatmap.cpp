@@ -0,0 +1,50 @@
+#include "OptionsVisualizer/core/heatmap.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+
+namespace heatmap {
+
+Range greekRange(const GridBlock::View& block,
+                 const Enums::GreekType greekType) {
+  constexpr double inf{std::numeric_limits<double>::infinity()};
+  double lo{inf};
+  double hi{-inf};
+
+  for (std::size_t optIdx{0}; optIdx < Enums::idx(Enums::OptionType::COUNT);
+       ++optIdx) {
+    const GridBlock::ConstGrid grid{block.grid(
+        optIdx * Enums::idx(Enums::GreekType::COUNT) + Enums::idx(greekType))};
+
+    // Degenerate cells (e.g. NaN greeks) don't stretch the color scale
+    for (Eigen::Index idx{0}; idx < grid.size(); ++idx) {
+      const double value{grid.data()[idx]};
+
+      if (std::isfinite(value)) {
+        lo = std::min(lo, value);
+        hi = std::max(hi, value);
+      }
+    }
+  }
+
+  if (lo > hi) {
+    constexpr double nan{std::numeric_limits<double>::quiet_NaN()};
+    return Range{.min_ = nan, .max_ = nan};
+  }
+
+  return Range{.min_ = lo, .max_ = hi};
+}
+
+void narrow(const GridBlock::ConstGrid& grid, float* const out) {
+  for (Eigen::Index idx{0}; idx < grid.size(); ++idx) {
+    out[idx] = static_cast<float>(grid.data()[idx]);
+  }
+}
+
+}  // namespace heatmap
@@ -1,8 +1,61 @@
 #include "OptionsVisualizer/core/linspace.hpp"
 
 #include <Eigen/Dense>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "OptionsVisualizer/core/Enums.hpp"
 
 Eigen::ArrayXd linspace(const Eigen::Index size, const double lo,
                         const double hi) {
   return Eigen::ArrayXd::LinSpaced(size, lo, hi);
 }
+
+Eigen::ArrayXd logspace(const Eigen::Index size, const double lo,
+                        const double hi) {
+  if (!(lo > 0.0 && hi > 0.0)) {
+    throw std::invalid_argument{"Log-spaced axis bounds must be positive"};
+  }
+
+  Eigen::ArrayXd points{linspace(size, std::log(lo), std::log(hi)).exp()};
+
+  // Keep the bounds exact so the axis covers the same range as linspace
+  if (size > 1) {
+    points(0) = lo;
+    points(size - 1) = hi;
+  } else if (size == 1) {
+    points(0) = hi;
+  }
+
+  return points;
+}
+
+Eigen::ArrayXd chebspace(const Eigen::Index size, const double lo,
+                         const double hi) {
+  if (size < 2) {
+    return linspace(size, lo, hi);
+  }
+
+  // x_i = (lo + hi) / 2 - (hi - lo) / 2 * cos(pi * i / (n - 1))
+  const Eigen::ArrayXd angles{linspace(size, 0.0, std::numbers::pi)};
+  Eigen::ArrayXd points{0.5 * (lo + hi) - 0.5 * (hi - lo) * angles.cos()};
+  points(0) = lo;
+  points(size - 1) = hi;
+  return points;
+}
+
+Eigen::ArrayXd makeAxis(const Enums::AxisSpacing spacing,
+                        const Eigen::Index size, const double lo,
+                        const double hi) {
+  switch (spacing) {
+    case Enums::AxisSpacing::Log:
+      return logspace(size, lo, hi);
+    case Enums::AxisSpacing::Chebyshev:
+      return chebspace(size, lo, hi);
+    case Enums::AxisSpacing::Linear:
+      break;
+  }
+
+  return linspace(size, lo, hi);
+}
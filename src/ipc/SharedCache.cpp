@@ -0,0 +1,348 @@
+#include "OptionsVisualizer/ipc/SharedCache.hpp"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingParams.hpp"
+
+namespace ipc {
+
+// Start of the index segment, followed by `capacity_` slots. The creator
+// publishes `magic_` last so attaching processes never use a half-initialized
+// index
+struct SharedCache::IndexHeader {
+  static constexpr std::uint32_t expectedMagic{0x4f565343};  // "OVSC"
+  static constexpr std::uint32_t expectedVersion{4};
+
+  std::atomic<std::uint32_t> magic_;
+  std::uint32_t version_;
+  std::uint64_t capacity_;
+  pthread_mutex_t mutex_;
+  std::uint64_t clock_;   // logical time used for LRU stamps
+  std::uint64_t nextId_;  // id of the next data segment
+};
+
+struct SharedCache::IndexSlot {
+  std::uint64_t occupied_;
+  std::uint64_t hash_;
+  PricingParams::Data key_;
+  Settings settings_;
+  std::uint64_t segmentId_;
+  std::uint64_t lastUsed_;
+};
+
+namespace {
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "Index magic must be lock-free to live in shared memory");
+
+// Attaching processes wait this long for the creator to initialize the index
+constexpr auto initTimeout{std::chrono::seconds{5}};
+
+[[noreturn]] void throwErrno(const int err, const std::string& what) {
+  throw std::system_error{err, std::generic_category(), what};
+}
+
+// Scoped lock on the index mutex that recovers it if its previous owner died
+class IndexLock {
+  pthread_mutex_t* mutex_;
+
+ public:
+  explicit IndexLock(pthread_mutex_t* const mutex) : mutex_{mutex} {
+    const int rc{::pthread_mutex_lock(mutex_)};
+
+    // The slots are only ever updated field by field with `occupied_` written
+    // last, so the index is still usable after its owner died
+    if (rc == EOWNERDEAD) {
+      ::pthread_mutex_consistent(mutex_);
+    } else if (rc != 0) {
+      throwErrno(rc, "pthread_mutex_lock");
+    }
+  }
+
+  IndexLock(const IndexLock&) = delete;
+  IndexLock& operator=(const IndexLock&) = delete;
+  ~IndexLock() { ::pthread_mutex_unlock(mutex_); }
+};
+
+}  // namespace
+
+SharedCache::SharedCache(std::string name, const std::size_t capacity,
+                         const models::trinomial::TreeSettings& settings)
+    : name_{std::move(name)},
+      settings_{settings.depth_,
+                std::bit_cast<std::int64_t>(settings.truncation_),
+                settings.skipExercise_, settings.controlVariate_},
+      index_{nullptr},
+      indexSize_{0} {
+  if (capacity < 1) {
+    throw std::invalid_argument{"Shared cache capacity must be at least 1"};
+  }
+
+  const std::string indexName{name_ + "-index"};
+  bool creator{true};
+  int fd{::shm_open(indexName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)};
+
+  if (fd == -1 && errno == EEXIST) {
+    creator = false;
+    fd = ::shm_open(indexName.c_str(), O_RDWR, 0);
+  }
+
+  if (fd == -1) {
+    throwErrno(errno, "shm_open " + indexName);
+  }
+
+  std::size_t size{sizeof(IndexHeader) + capacity * sizeof(IndexSlot)};
+
+  if (creator) {
+    if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+      const int err{errno};
+      ::close(fd);
+      ::shm_unlink(indexName.c_str());
+      throwErrno(err, "ftruncate " + indexName);
+    }
+  } else {
+    // The creator may not have sized the segment yet
+    const auto deadline{std::chrono::steady_clock::now() + initTimeout};
+    struct stat st {};
+
+    while (::fstat(fd, &st) == 0 &&
+           static_cast<std::size_t>(st.st_size) < sizeof(IndexHeader) &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    size = static_cast<std::size_t>(st.st_size);
+
+    if (size < sizeof(IndexHeader)) {
+      ::close(fd);
+      throw std::runtime_error{"Shared cache index not initialized: " +
+                               indexName};
+    }
+  }
+
+  void* const addr{
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)};
+  const int mmapErr{errno};
+  ::close(fd);
+
+  if (addr == MAP_FAILED) {
+    if (creator) {
+      ::shm_unlink(indexName.c_str());
+    }
+
+    throwErrno(mmapErr, "mmap " + indexName);
+  }
+
+  index_ = static_cast<IndexHeader*>(addr);
+  indexSize_ = size;
+
+  if (creator) {
+    // A fresh segment is zero-filled, so every slot starts out empty
+    index_->version_ = IndexHeader::expectedVersion;
+    index_->capacity_ = capacity;
+    index_->clock_ = 0;
+    index_->nextId_ = 0;
+
+    pthread_mutexattr_t attr{};
+    ::pthread_mutexattr_init(&attr);
+    ::pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    ::pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    ::pthread_mutex_init(&index_->mutex_, &attr);
+    ::pthread_mutexattr_destroy(&attr);
+
+    index_->magic_.store(IndexHeader::expectedMagic, std::memory_order_release);
+    return;
+  }
+
+  const auto deadline{std::chrono::steady_clock::now() + initTimeout};
+
+  while (index_->magic_.load(std::memory_order_acquire) !=
+             IndexHeader::expectedMagic &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  // Existing caches keep the capacity they were created with
+  if (index_->magic_.load(std::memory_order_acquire) !=
+          IndexHeader::expectedMagic ||
+      index_->version_ != IndexHeader::expectedVersion ||
+      sizeof(IndexHeader) + index_->capacity_ * sizeof(IndexSlot) > size) {
+    ::munmap(index_, indexSize_);
+    throw std::runtime_error{"Invalid shared cache index: " + indexName};
+  }
+}
+
+SharedCache::~SharedCache() { ::munmap(index_, indexSize_); }
+
+std::optional<SharedGrids> SharedCache::find(const PricingParams& params) {
+  const std::size_t paramsHash{hash(params)};
+  std::uint64_t segmentId{};
+
+  {
+    IndexLock lock{&index_->mutex_};
+    IndexSlot* const slot{findSlot(params, paramsHash)};
+
+    if (slot == nullptr) {
+      return std::nullopt;
+    }
+
+    slot->lastUsed_ = ++index_->clock_;
+    segmentId = slot->segmentId_;
+  }
+
+  // The entry may be evicted between releasing the lock and mapping it, in
+  // which case it's treated as a miss
+  try {
+    return SharedGrids::open(segmentName(segmentId));
+  } catch (const std::system_error& e) {
+    if (e.code() == std::errc::no_such_file_or_directory) {
+      return std::nullopt;
+    }
+
+    throw;
+  } catch (const std::runtime_error&) {
+    // A segment with another layout (e.g. left behind by an older build) is
+    // dropped so the entry gets priced and published again
+    IndexLock lock{&index_->mutex_};
+    IndexSlot* const slot{findSlot(params, paramsHash)};
+
+    if (slot != nullptr && slot->segmentId_ == segmentId) {
+      slot->occupied_ = 0;
+      SharedGrids::unlink(segmentName(segmentId));
+    }
+
+    return std::nullopt;
+  }
+}
+
+SharedGrids SharedCache::publish(const PricingParams& params,
+                                 const GridArray& grids) {
+  if (std::optional<SharedGrids> existing{find(params)}) {
+    return std::move(*existing);
+  }
+
+  const std::size_t paramsHash{hash(params)};
+  std::uint64_t segmentId{};
+
+  {
+    IndexLock lock{&index_->mutex_};
+    segmentId = index_->nextId_++;
+  }
+
+  // Copy the grids without holding the lock
+  SharedGrids segment{SharedGrids::create(segmentName(segmentId), grids)};
+
+  {
+    IndexLock lock{&index_->mutex_};
+
+    // Another process published the same parameters in the meantime (our
+    // segment is unlinked when it goes out of scope)
+    if (findSlot(params, paramsHash) == nullptr) {
+      IndexSlot* victim{slots()};
+
+      for (IndexSlot* slot{slots()}; slot != slots() + index_->capacity_;
+           ++slot) {
+        if (slot->occupied_ == 0) {
+          victim = slot;
+          break;
+        }
+
+        if (slot->lastUsed_ < victim->lastUsed_) {
+          victim = slot;
+        }
+      }
+
+      // Processes that already mapped the evicted entry keep their mapping
+      if (victim->occupied_ != 0) {
+        victim->occupied_ = 0;
+        SharedGrids::unlink(segmentName(victim->segmentId_));
+      }
+
+      victim->hash_ = paramsHash;
+      victim->key_ = params.data();
+      victim->settings_ = settings_;
+      victim->segmentId_ = segmentId;
+      victim->lastUsed_ = ++index_->clock_;
+      victim->occupied_ = 1;
+      segment.disown();
+      return segment;
+    }
+  }
+
+  if (std::optional<SharedGrids> existing{find(params)}) {
+    return std::move(*existing);
+  }
+
+  throw std::runtime_error{"Shared cache entry evicted while publishing"};
+}
+
+void SharedCache::destroy(const std::string& name) {
+  {
+    // Capacity is ignored when attaching to an existing index
+    SharedCache cache{name, 1};
+    IndexLock lock{&cache.index_->mutex_};
+
+    for (IndexSlot* slot{cache.slots()};
+         slot != cache.slots() + cache.index_->capacity_; ++slot) {
+      if (slot->occupied_ != 0) {
+        slot->occupied_ = 0;
+        SharedGrids::unlink(cache.segmentName(slot->segmentId_));
+      }
+    }
+  }
+
+  SharedGrids::unlink(name + "-index");
+}
+
+std::string SharedCache::segmentName(const std::uint64_t id) const {
+  return name_ + "-" + std::to_string(id);
+}
+
+SharedCache::IndexSlot* SharedCache::slots() const noexcept {
+  return std::launder(reinterpret_cast<IndexSlot*>(index_ + 1));
+}
+
+std::size_t SharedCache::hash(const PricingParams& params) const noexcept {
+  std::size_t seed{PricingParamsHash{}(params)};
+
+  for (const std::int64_t setting : settings_) {
+    PricingParamsHash::hashCombine(seed, static_cast<std::size_t>(setting));
+  }
+
+  return seed;
+}
+
+SharedCache::IndexSlot* SharedCache::findSlot(
+    const PricingParams& params, const std::size_t hash) const noexcept {
+  // A linear scan is cheap next to pricing even for thousands of slots and
+  // keeps eviction trivial (no probe chains to repair)
+  for (IndexSlot* slot{slots()}; slot != slots() + index_->capacity_; ++slot) {
+    if (slot->occupied_ != 0 && slot->hash_ == hash &&
+        slot->key_ == params.data() && slot->settings_ == settings_) {
+      return slot;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace ipc
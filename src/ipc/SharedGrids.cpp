@@ -0,0 +1,205 @@
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+
+namespace ipc {
+
+namespace {
+
+// Grids start on cache line boundaries
+constexpr std::size_t gridAlignment{64};
+
+[[nodiscard]] constexpr std::size_t alignUp(const std::size_t n) noexcept {
+  return ((n + gridAlignment - 1) / gridAlignment) * gridAlignment;
+}
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::system_error{errno, std::generic_category(), what};
+}
+
+}  // namespace
+
+SharedGrids::SharedGrids(std::string name, std::byte* const addr,
+                         const std::size_t size, const bool owner)
+    : name_{std::move(name)}, addr_{addr}, size_{size}, owner_{owner} {}
+
+SharedGrids SharedGrids::create(const std::string& name,
+                                const GridArray& grids) {
+  const Eigen::Index nSigma{grids.rows()};
+  const Eigen::Index nStrike{grids.cols()};
+  const std::size_t gridBytes{static_cast<std::size_t>(nSigma * nStrike) *
+                              sizeof(double)};
+  const std::size_t dataOffset{alignUp(sizeof(SegmentHeader))};
+  const std::size_t gridStride{alignUp(gridBytes)};
+  const std::size_t size{dataOffset + gridStride * globals::nGrids};
+
+  const int fd{::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)};
+
+  if (fd == -1) {
+    throwErrno("shm_open " + name);
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+    const int err{errno};
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    errno = err;
+    throwErrno("ftruncate " + name);
+  }
+
+  void* const addr{
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)};
+  ::close(fd);
+
+  if (addr == MAP_FAILED) {
+    const int err{errno};
+    ::shm_unlink(name.c_str());
+    errno = err;
+    throwErrno("mmap " + name);
+  }
+
+  // Take ownership before writing so the segment is cleaned up on failure
+  SharedGrids segment{name, static_cast<std::byte*>(addr), size, true};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    std::memcpy(segment.addr_ + dataOffset + idx * gridStride,
+                grids[idx].data(), gridBytes);
+  }
+
+  // Publish the header last so readers never see a partially written segment
+  const SegmentHeader header{.magic_ = SegmentHeader::expectedMagic,
+                             .version_ = SegmentHeader::expectedVersion,
+                             .nSigma_ = nSigma,
+                             .nStrike_ = nStrike,
+                             .nGrids_ = globals::nGrids,
+                             .dataOffset_ = dataOffset,
+                             .gridStride_ = gridStride};
+  std::memcpy(segment.addr_, &header, sizeof(header));
+  return segment;
+}
+
+SharedGrids SharedGrids::open(const std::string& name) {
+  const int fd{::shm_open(name.c_str(), O_RDONLY, 0)};
+
+  if (fd == -1) {
+    throwErrno("shm_open " + name);
+  }
+
+  struct stat st {};
+
+  if (::fstat(fd, &st) == -1) {
+    const int err{errno};
+    ::close(fd);
+    errno = err;
+    throwErrno("fstat " + name);
+  }
+
+  const auto size{static_cast<std::size_t>(st.st_size)};
+  void* const addr{::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+  ::close(fd);
+
+  if (addr == MAP_FAILED) {
+    throwErrno("mmap " + name);
+  }
+
+  SharedGrids segment{name, static_cast<std::byte*>(addr), size, false};
+  const SegmentHeader& header{segment.header()};
+
+  if (size < sizeof(SegmentHeader) ||
+      header.magic_ != SegmentHeader::expectedMagic ||
+      header.version_ != SegmentHeader::expectedVersion ||
+      header.nGrids_ != globals::nGrids ||
+      header.dataOffset_ + header.gridStride_ * header.nGrids_ > size) {
+    throw std::runtime_error{"Invalid grid segment: " + name};
+  }
+
+  return segment;
+}
+
+SharedGrids::SharedGrids(SharedGrids&& other) noexcept
+    : name_{std::move(other.name_)},
+      addr_{std::exchange(other.addr_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      owner_{std::exchange(other.owner_, false)} {}
+
+SharedGrids& SharedGrids::operator=(SharedGrids&& other) noexcept {
+  if (this != &other) {
+    release();
+    name_ = std::move(other.name_);
+    addr_ = std::exchange(other.addr_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    owner_ = std::exchange(other.owner_, false);
+  }
+
+  return *this;
+}
+
+SharedGrids::~SharedGrids() { release(); }
+
+const SegmentHeader& SharedGrids::header() const noexcept {
+  return *reinterpret_cast<const SegmentHeader*>(addr_);
+}
+
+Eigen::Map<const Eigen::ArrayXXd> SharedGrids::grid(
+    const std::size_t idx) const {
+  if (idx >= globals::nGrids) {
+    throw std::out_of_range{"Grid index out of range"};
+  }
+
+  const SegmentHeader& h{header()};
+  const auto* const data{reinterpret_cast<const double*>(
+      addr_ + h.dataOffset_ + idx * h.gridStride_)};
+  return Eigen::Map<const Eigen::ArrayXXd>{data, h.nSigma_, h.nStrike_};
+}
+
+GridBlock::View SharedGrids::view() const noexcept {
+  const SegmentHeader& h{header()};
+  return GridBlock::View{
+      .data_ = reinterpret_cast<const double*>(addr_ + h.dataOffset_),
+      .nSigma_ = h.nSigma_,
+      .nStrike_ = h.nStrike_,
+      .gridStride_ = static_cast<Eigen::Index>(h.gridStride_ / sizeof(double))};
+}
+
+SharedGrids::GridArray SharedGrids::toGrids() const {
+  const SegmentHeader& h{header()};
+  GridArray grids{h.nSigma_, h.nStrike_};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids[idx] = grid(idx);
+  }
+
+  return grids;
+}
+
+void SharedGrids::unlink(const std::string& name) noexcept {
+  ::shm_unlink(name.c_str());
+}
+
+void SharedGrids::release() noexcept {
+  if (addr_ != nullptr) {
+    ::munmap(addr_, size_);
+    addr_ = nullptr;
+  }
+
+  if (owner_) {
+    ::shm_unlink(name_.c_str());
+    owner_ = false;
+  }
+}
+
+}  // namespace ipc
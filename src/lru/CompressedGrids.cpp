@@ -0,0 +1,138 @@
+#include "OptionsVisualizer/lru/CompressedGrids.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+
+namespace {
+
+constexpr double maxCode{std::numeric_limits<std::uint16_t>::max()};
+
+// Copy a typed buffer into raw bytes (and back) without aliasing issues
+template <typename T>
+[[nodiscard]] std::vector<std::byte> toBytes(const std::vector<T>& values) {
+  std::vector<std::byte> bytes(values.size() * sizeof(T));
+  std::memcpy(bytes.data(), values.data(), bytes.size());
+  return bytes;
+}
+
+template <typename T>
+[[nodiscard]] std::vector<T> fromBytes(const std::vector<std::byte>& bytes) {
+  std::vector<T> values(bytes.size() / sizeof(T));
+  std::memcpy(values.data(), bytes.data(), bytes.size());
+  return values;
+}
+
+}  // namespace
+
+CompressedGrids::CompressedGrids(const GridArray& grids,
+                                 const double tolerance)
+    : nSigma_{grids.rows()}, nStrike_{grids.cols()}, grids_{} {
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids_[idx] = encode(grids[idx], tolerance);
+  }
+}
+
+CompressedGrids::GridArray CompressedGrids::decompress() const {
+  GridArray grids{nSigma_, nStrike_};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    decode(grids_[idx], grids[idx]);
+  }
+
+  return grids;
+}
+
+std::size_t CompressedGrids::size() const noexcept {
+  std::size_t bytes{0};
+
+  for (const Grid& grid : grids_) {
+    bytes += grid.bytes_.size();
+  }
+
+  return bytes;
+}
+
+CompressedGrids::Grid CompressedGrids::encode(
+    const GridBlock::ConstGrid& grid, const double tolerance) {
+  const auto n{static_cast<std::size_t>(grid.size())};
+
+  // NaNs/infinities (e.g. degenerate greeks) are kept exactly
+  if (grid.allFinite()) {
+    const double bound{tolerance * grid.abs().maxCoeff()};
+    const double lo{grid.minCoeff()};
+    const double step{(grid.maxCoeff() - lo) / maxCode};
+
+    // Rounding to the nearest code is off by at most half a step
+    if (step / 2.0 <= bound) {
+      std::vector<std::uint16_t> codes(n, 0);
+
+      if (step > 0.0) {
+        for (std::size_t i{0}; i < n; ++i) {
+          codes[i] = static_cast<std::uint16_t>(
+              std::lround((grid.data()[i] - lo) / step));
+        }
+      }
+
+      return Grid{.encoding_ = Encoding::Quantized16,
+                  .offset_ = lo,
+                  .step_ = step,
+                  .bytes_ = toBytes(codes)};
+    }
+
+    // Float rounding is relative to each value, so check it explicitly
+    std::vector<float> floats(n);
+    bool withinBound{true};
+
+    for (std::size_t i{0}; i < n; ++i) {
+      floats[i] = static_cast<float>(grid.data()[i]);
+      withinBound = withinBound && std::abs(static_cast<double>(floats[i]) -
+                                            grid.data()[i]) <= bound;
+    }
+
+    if (withinBound) {
+      return Grid{.encoding_ = Encoding::Float32,
+                  .offset_ = 0.0,
+                  .step_ = 0.0,
+                  .bytes_ = toBytes(floats)};
+    }
+  }
+
+  return Grid{
+      .encoding_ = Encoding::Float64,
+      .offset_ = 0.0,
+      .step_ = 0.0,
+      .bytes_ = toBytes(std::vector<double>(grid.data(), grid.data() + n))};
+}
+
+void CompressedGrids::decode(const Grid& grid, GridBlock::Grid out) {
+  switch (grid.encoding_) {
+    case Encoding::Quantized16: {
+      const std::vector<std::uint16_t> codes{
+          fromBytes<std::uint16_t>(grid.bytes_)};
+
+      for (std::size_t i{0}; i < codes.size(); ++i) {
+        out.data()[i] = grid.offset_ + grid.step_ * codes[i];
+      }
+
+      break;
+    }
+
+    case Encoding::Float32: {
+      const std::vector<float> floats{fromBytes<float>(grid.bytes_)};
+      std::copy(floats.cbegin(), floats.cend(), out.data());
+      break;
+    }
+
+    case Encoding::Float64:
+      std::memcpy(out.data(), grid.bytes_.data(), grid.bytes_.size());
+      break;
+  }
+}
@@ -1,33 +1,41 @@
 #include <Eigen/Dense>
 #include <cmath>
 #include <numbers>
-#include <unsupported/Eigen/SpecialFunctions>  // error function
 #include <utility>
 
+#include "OptionsVisualizer/core/ScratchArena.hpp"
+#include "OptionsVisualizer/models/bsm/calculate_price.hpp"
 #include "OptionsVisualizer/pricing/GreeksResult.hpp"
 #include "OptionsVisualizer/pricing/PricingSurface.hpp"
 
-GreeksResult PricingSurface::bsmCallGreeks() const {
-  // BSM intermediate term d1 = (log(S / K) + ((r - q - simga^2 / 2) * T)) /
-  // sigma * sqrt(T)
-  const double sqrtTau{std::sqrt(tau_)};
-  const Eigen::ArrayXXd sigmaSqrtTau{sigmasGrid_ * sqrtTau};
-  const Eigen::ArrayXXd d1{((spot_ / strikesGrid_).log() +
-                            (((r_ - q_) + 0.5 * sigmasGrid_.square()) * tau_)) /
-                           sigmaSqrtTau};
+PricingSurface::BsmTerms PricingSurface::bsmTerms() const {
+  return BsmTerms{.logMoneyness_ = (spot_ / strikesGrid_).log(),
+                  .drift_ = (r_ - q_) + 0.5 * sigmasGrid_.square()};
+}
+
+GreeksResult PricingSurface::bsmCallGreeks(const BsmTerms& terms) const {
+  // Intermediate grids are only needed to build the results so they come from
+  // the thread's scratch arena
+  Utils::ScratchArena::Scope scratch{};
+  const Eigen::Index nRows{sigmasGrid_.rows()};
+  const Eigen::Index nCols{sigmasGrid_.cols()};
 
-  // BSM intermediate term d2 = d1 - sigma * sqrt(T)
+  // BSM intermediate terms d1 and d2 = d1 - sigma * sqrt(T) with N(d1) and
+  // N(d2) (shared with the closed-form prices used by the control variate)
+  const double sqrtTau{std::sqrt(tau_)};
+  auto [sigmaSqrtTau, d1, cdfD1, cdfD2]{scratch.arrays<4>(nRows, nCols)};
+  models::bsm::priceTerms(terms.logMoneyness_, terms.drift_, sigmasGrid_, tau_,
+                          sigmaSqrtTau, d1, cdfD1, cdfD2);
   const auto d2{d1 - sigmaSqrtTau};
 
-  // --- Standard normal CDF and PDF using error function
+  // --- Standard normal PDF
   using std::numbers::sqrt2;
-  const Eigen::ArrayXXd cdfD1{0.5 * (1.0 + (d1 / sqrt2).erf())};
-  const Eigen::ArrayXXd cdfD2{0.5 * (1.0 + (d2 / sqrt2).erf())};
 
   // 1 / sqrt(2pi) = (1 / sqrt(pi)) * (1 / sqrt(2)) = (1 / sqrt(pi)) * (sqrt(2)
   // / 2)
   constexpr double invSqrt2pi{std::numbers::inv_sqrtpi * sqrt2 / 2.0};
-  const Eigen::ArrayXXd pdfD1{invSqrt2pi * (-0.5 * d1.square()).exp()};
+  Utils::ScratchArena::ArrayMap pdfD1{scratch.array(nRows, nCols)};
+  pdfD1 = invSqrt2pi * (-0.5 * d1.square()).exp();
 
   // Constant exponential factors
   const double expQTau{std::exp(-q_ * tau_)};
@@ -35,9 +43,9 @@ GreeksResult PricingSurface::bsmCallGreeks() const {
 
   // --- Calculate results
 
-  // price = (S * e^(-qT) * N(d1)) - (K * e^(-rT) * N(d2))
-  Eigen::ArrayXXd price{((spot_ * expQTau) * cdfD1) -
-                        (strikesGrid_ * expRTau * cdfD2)};
+  Eigen::ArrayXXd price{nRows, nCols};
+  models::bsm::callPrice(spot_, r_, q_, strikesGrid_, tau_, cdfD1, cdfD2,
+                         price);
 
   // See Hull (ch. 18 - 398)
   // delta = e^(-qT) * N(d1)
@@ -59,8 +67,22 @@ GreeksResult PricingSurface::bsmCallGreeks() const {
   // rho = K * T * e^(-rT) * N(d2)
   Eigen::ArrayXXd rho{strikesGrid_ * (tau_ * expRTau) * cdfD2};
 
+  // vanna = -e^(-qT) * N'(d1) * d2 / sigma
+  Eigen::ArrayXXd vanna{-expQTau * pdfD1 * d2 / sigmasGrid_};
+
+  // volga = vega * d1 * d2 / sigma
+  Eigen::ArrayXXd volga{vega * d1 * d2 / sigmasGrid_};
+
+  // charm = (q * e^(-qT) * N(d1)) - (e^(-qT) * N'(d1) * (2 * (r - q) * T - d2
+  // * sigma * sqrt(T)) / (2 * T * sigma * sqrt(T)))
+  Eigen::ArrayXXd charm{
+      ((q_ * expQTau) * cdfD1) -
+      (expQTau * pdfD1 * ((2.0 * (r_ - q_) * tau_) - (d2 * sigmaSqrtTau)) /
+       (2.0 * tau_ * sigmaSqrtTau))};
+
   return GreeksResult{std::move(price), std::move(delta), std::move(gamma),
-                      std::move(vega),  std::move(theta), std::move(rho)};
+                      std::move(vega),  std::move(theta), std::move(rho),
+                      std::move(vanna), std::move(volga), std::move(charm)};
 }
 
 GreeksResult PricingSurface::bsmPutGreeks(
@@ -96,10 +118,21 @@ GreeksResult PricingSurface::bsmPutGreeks(
   */
   Eigen::ArrayXXd rho{callResults.rho_ - (strikesGrid_ * (tau_ * expRTau))};
 
+  /*
+      charm_call - charm_put = d/dt[delta_call - delta_put]
+                             = d/dt[e^(-qT)]
+                             = q * e^(-qT)
+      -> charm_put = charm_call - q * e^(-qT)
+  */
+  Eigen::ArrayXXd charm{callResults.charm_ - (q_ * expQTau)};
+
   return GreeksResult{std::move(price),
                       std::move(delta),
                       Eigen::ArrayXXd{callResults.gamma_},
                       Eigen::ArrayXXd{callResults.vega_},
                       std::move(theta),
-                      std::move(rho)};
+                      std::move(rho),
+                      Eigen::ArrayXXd{callResults.vanna_},
+                      Eigen::ArrayXXd{callResults.volga_},
+                      std::move(charm)};
 }
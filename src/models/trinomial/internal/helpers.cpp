@@ -1,21 +1,42 @@
 #include "OptionsVisualizer/models/trinomial/internal/helpers.hpp"
 
 #include <Eigen/Dense>
-#include <utility>
+#include <limits>
+
+#include "OptionsVisualizer/models/trinomial/internal/node_update.hpp"
 
 namespace models::trinomial::helpers {
 
-Eigen::ArrayXXd buildSpotLattice(const double spot, const Eigen::ArrayXd& u,
-                                 const Eigen::Index depth) {
-  // Create the exponents: [-depth, ..., 0, ..., depth]
-  const Eigen::Index nNodes{2 * depth + 1};
-  const double depDbl{static_cast<double>(depth)};
-  Eigen::ArrayXd exponents{Eigen::ArrayXd::LinSpaced(nNodes, -depDbl, depDbl)};
-
-  // Generate a 2D grid where each cell (i, j) = spot * u[j]^{exponents[i]}
-  // using the identity u^k = exp(k * ln(u)) via matrix outer product for speed
-  return spot *
-         (exponents.matrix() * u.log().matrix().transpose()).array().exp();
+int selectTileHeight(const Eigen::Index nRows) noexcept {
+  // Rows per vector of the node-update kernel on this CPU
+  static const Eigen::Index lanes{[] {
+    switch (internal::detectSimdLevel()) {
+      case internal::SimdLevel::AVX512:
+        return Eigen::Index{8};
+      case internal::SimdLevel::AVX2:
+        return Eigen::Index{4};
+      default:
+        return Eigen::Index{2};
+    }
+  }()};
+
+  int best{tileHeights.front()};
+  Eigen::Index bestCost{std::numeric_limits<Eigen::Index>::max()};
+
+  // Heights are ordered from largest to smallest so ties keep the taller tile
+  for (const int tile : tileHeights) {
+    // Vector operations per node once the last tile is padded up to a full
+    // tile (a tile narrower than a vector still costs a whole one)
+    const Eigen::Index nTiles{(nRows + tile - 1) / tile};
+    const Eigen::Index cost{nTiles * ((tile + lanes - 1) / lanes)};
+
+    if (cost < bestCost) {
+      best = tile;
+      bestCost = cost;
+    }
+  }
+
+  return best;
 }
 
 }  // namespace models::trinomial::helpers
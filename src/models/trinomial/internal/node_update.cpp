@@ -0,0 +1,222 @@
+#include "OptionsVisualizer/models/trinomial/internal/node_update.hpp"
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/helpers.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define OPTIONS_VISUALIZER_X86_KERNELS 1
+#endif
+
+namespace models::trinomial::internal {
+
+namespace {
+
+template <Enums::OptionType OptType>
+inline constexpr bool isCall{OptType == Enums::OptionType::AmerCall};
+
+template <Enums::OptionType OptType>
+inline constexpr bool isAmerican{OptType == Enums::OptionType::AmerCall ||
+                                 OptType == Enums::OptionType::AmerPut};
+
+// Portable kernel (Eigen vectorizes the fixed-size columns for the baseline
+// instruction set)
+template <Enums::OptionType OptType, int Tile>
+void rollBackGeneric(const NodeCoefficients& c, double* const values,
+                     const double* const spots, const Eigen::Index first,
+                     const Eigen::Index last) {
+  using Column = Eigen::Array<double, Tile, 1>;
+  const Column pU{Eigen::Map<const Column>{c.pU_}};
+  const Column pM{Eigen::Map<const Column>{c.pM_}};
+  const Column pD{Eigen::Map<const Column>{c.pD_}};
+  const Column strikes{Eigen::Map<const Column>{c.strikes_}};
+
+  for (Eigen::Index node{first}; node <= last; ++node) {
+    Eigen::Map<Column> valD{values + node * Tile};
+    const Eigen::Map<const Column> valM{values + (node + 1) * Tile};
+    const Eigen::Map<const Column> valU{values + (node + 2) * Tile};
+    const Eigen::Map<const Column> nodeSpots{spots + node * Tile};
+
+    const Column continuation{(pU * valU + pM * valM + pD * valD) *
+                              c.discountFactor_};
+
+    if constexpr (isAmerican<OptType>) {
+      valD = continuation.cwiseMax(
+          helpers::intrinsicValue<OptType>(nodeSpots, strikes));
+    } else {
+      valD = continuation;
+    }
+  }
+}
+
+#ifdef OPTIONS_VISUALIZER_X86_KERNELS
+
+// 4 rows per 256-bit vector
+template <Enums::OptionType OptType, int Tile>
+__attribute__((target("avx2"))) void rollBackAvx2(
+    const NodeCoefficients& c, double* const values, const double* const spots,
+    const Eigen::Index first, const Eigen::Index last) {
+  static_assert(Tile % 4 == 0, "AVX2 kernel expects whole 256-bit vectors");
+  const __m256d df{_mm256_set1_pd(c.discountFactor_)};
+  const __m256d zero{_mm256_setzero_pd()};
+
+  for (int t{0}; t < Tile; t += 4) {
+    const __m256d pU{_mm256_loadu_pd(c.pU_ + t)};
+    const __m256d pM{_mm256_loadu_pd(c.pM_ + t)};
+    const __m256d pD{_mm256_loadu_pd(c.pD_ + t)};
+    const __m256d strikes{_mm256_loadu_pd(c.strikes_ + t)};
+
+    for (Eigen::Index node{first}; node <= last; ++node) {
+      double* const v{values + node * Tile + t};
+      const __m256d sum{_mm256_add_pd(
+          _mm256_add_pd(_mm256_mul_pd(pU, _mm256_loadu_pd(v + 2 * Tile)),
+                        _mm256_mul_pd(pM, _mm256_loadu_pd(v + Tile))),
+          _mm256_mul_pd(pD, _mm256_loadu_pd(v)))};
+      const __m256d continuation{_mm256_mul_pd(sum, df)};
+
+      if constexpr (isAmerican<OptType>) {
+        const __m256d nodeSpots{_mm256_loadu_pd(spots + node * Tile + t)};
+        const __m256d intrinsic{_mm256_max_pd(
+            isCall<OptType> ? _mm256_sub_pd(nodeSpots, strikes)
+                            : _mm256_sub_pd(strikes, nodeSpots),
+            zero)};
+        _mm256_storeu_pd(v, _mm256_max_pd(continuation, intrinsic));
+      } else {
+        _mm256_storeu_pd(v, continuation);
+      }
+    }
+  }
+}
+
+// Element-wise max with every lane selected (GCC 12's _mm512_max_pd trips
+// -Wmaybe-uninitialized on its internal undefined source operand)
+__attribute__((target("avx512f"))) inline __m512d max512(const __m512d a,
+                                                         const __m512d b) {
+  return _mm512_mask_max_pd(a, __mmask8{0xFF}, a, b);
+}
+
+// 8 rows per 512-bit vector
+template <Enums::OptionType OptType, int Tile>
+__attribute__((target("avx512f"))) void rollBackAvx512(
+    const NodeCoefficients& c, double* const values, const double* const spots,
+    const Eigen::Index first, const Eigen::Index last) {
+  static_assert(Tile % 8 == 0, "AVX-512 kernel expects whole 512-bit vectors");
+  const __m512d df{_mm512_set1_pd(c.discountFactor_)};
+  const __m512d zero{_mm512_setzero_pd()};
+
+  for (int t{0}; t < Tile; t += 8) {
+    const __m512d pU{_mm512_loadu_pd(c.pU_ + t)};
+    const __m512d pM{_mm512_loadu_pd(c.pM_ + t)};
+    const __m512d pD{_mm512_loadu_pd(c.pD_ + t)};
+    const __m512d strikes{_mm512_loadu_pd(c.strikes_ + t)};
+
+    for (Eigen::Index node{first}; node <= last; ++node) {
+      double* const v{values + node * Tile + t};
+      const __m512d sum{_mm512_add_pd(
+          _mm512_add_pd(_mm512_mul_pd(pU, _mm512_loadu_pd(v + 2 * Tile)),
+                        _mm512_mul_pd(pM, _mm512_loadu_pd(v + Tile))),
+          _mm512_mul_pd(pD, _mm512_loadu_pd(v)))};
+      const __m512d continuation{_mm512_mul_pd(sum, df)};
+
+      if constexpr (isAmerican<OptType>) {
+        const __m512d nodeSpots{_mm512_loadu_pd(spots + node * Tile + t)};
+        const __m512d intrinsic{
+            max512(isCall<OptType> ? _mm512_sub_pd(nodeSpots, strikes)
+                                   : _mm512_sub_pd(strikes, nodeSpots),
+                   zero)};
+        _mm512_storeu_pd(v, max512(continuation, intrinsic));
+      } else {
+        _mm512_storeu_pd(v, continuation);
+      }
+    }
+  }
+}
+
+#endif
+
+[[nodiscard]] SimdLevel supportedSimdLevel() noexcept {
+#ifdef OPTIONS_VISUALIZER_X86_KERNELS
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+
+  return SimdLevel::Generic;
+}
+
+}  // namespace
+
+SimdLevel detectSimdLevel() noexcept {
+  static const SimdLevel level{[] {
+    const SimdLevel supported{supportedSimdLevel()};
+    const char* const requested{std::getenv("OPTIONS_VISUALIZER_SIMD")};
+
+    if (requested == nullptr) {
+      return supported;
+    }
+
+    const std::string_view name{requested};
+    const SimdLevel cap{name == "generic" ? SimdLevel::Generic
+                        : name == "avx2"  ? SimdLevel::AVX2
+                                          : SimdLevel::AVX512};
+    return std::min(supported, cap);
+  }()};
+
+  return level;
+}
+
+template <Enums::OptionType OptType, int Tile>
+RollBackKernel rollBackKernel(const SimdLevel level) noexcept {
+#ifdef OPTIONS_VISUALIZER_X86_KERNELS
+  if constexpr (Tile % 8 == 0) {
+    if (level == SimdLevel::AVX512) {
+      return &rollBackAvx512<OptType, Tile>;
+    }
+  }
+
+  if constexpr (Tile % 4 == 0) {
+    if (level >= SimdLevel::AVX2) {
+      return &rollBackAvx2<OptType, Tile>;
+    }
+  }
+#else
+  static_cast<void>(level);
+#endif
+
+  return &rollBackGeneric<OptType, Tile>;
+}
+
+// Kernels for every option type and tile height (see helpers::tileHeights)
+#define OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(OptType, Tile)            \
+  template RollBackKernel rollBackKernel<Enums::OptionType::OptType, \
+                                         Tile>(SimdLevel) noexcept;
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerCall, 8)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerCall, 4)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerCall, 2)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerCall, 1)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerPut, 8)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerPut, 4)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerPut, 2)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(AmerPut, 1)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroCall, 8)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroCall, 4)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroCall, 2)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroCall, 1)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroPut, 8)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroPut, 4)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroPut, 2)
+OPTIONS_VISUALIZER_ROLL_BACK_KERNEL(EuroPut, 1)
+#undef OPTIONS_VISUALIZER_ROLL_BACK_KERNEL
+
+}  // namespace models::trinomial::internal
@@ -2,80 +2,716 @@
 #include <pybind11/native_enum.h>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include <Eigen/Dense>
-#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
 #include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/heatmap.hpp"
 #include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/Portfolio.hpp"
+#include "OptionsVisualizer/pricing/ProgressiveSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
 namespace py = pybind11;
 
+namespace {
+
+constexpr auto nGreeks{
+    static_cast<py::ssize_t>(Enums::idx(Enums::GreekType::COUNT))};
+constexpr auto nOptTypes{
+    static_cast<py::ssize_t>(Enums::idx(Enums::OptionType::COUNT))};
+constexpr py::ssize_t szDbl{sizeof(double)};
+
+// Wrap one greek for every option type in read-only numpy views of a block of
+// grids (`owner` keeps the memory alive for as long as the arrays are
+// referenced)
+py::tuple greekViews(const GridBlock::View& block,
+                     const Enums::GreekType greekType,
+                     const py::object& owner) {
+  const auto greekIdx{static_cast<py::ssize_t>(Enums::idx(greekType))};
+  py::tuple output{nOptTypes};
+
+  for (py::ssize_t optIdx{0}; optIdx < nOptTypes; ++optIdx) {
+    const GridBlock::ConstGrid grid{
+        block.grid(static_cast<std::size_t>(optIdx * nGreeks + greekIdx))};
+
+    // Strides are defined for column-major order
+    static_assert(!GridBlock::ConstGrid::IsRowMajor,
+                  "Strides are defined for column-major storage order.");
+
+    // Map an Eigen array to a numpy array without copying the underlying data
+    output[static_cast<std::size_t>(optIdx)] = py::array{
+        // Shape
+        {grid.rows(), grid.cols()},
+        // Strides (defined for column major order)
+        {
+            szDbl,                      // distance to next row
+            szDbl * grid.outerStride()  // distance to next column
+        },
+        // Data pointer
+        grid.data(),
+        // Owner/handle (tells python not to delete this memory when the array
+        // goes out of scope)
+        owner};
+
+    // Don't allow the object to be writeable in python
+    output[static_cast<std::size_t>(optIdx)].attr("flags").attr("writeable") =
+        false;
+  }
+
+  return output;
+}
+
+// Every grid of a block as one read-only (option type, greek, sigma, strike)
+// numpy array, without copying
+py::array blockView(const GridBlock::View& block, const py::object& owner) {
+  const py::ssize_t gridBytes{szDbl * block.gridStride_};
+  py::array output{
+      // Shape
+      {nOptTypes, nGreeks, block.nSigma_, block.nStrike_},
+      // Strides (grids are column-major and padded to whole cache lines)
+      {gridBytes * nGreeks, gridBytes, szDbl, szDbl * block.nSigma_},
+      // Data pointer
+      block.data_,
+      // Owner/handle
+      owner};
+  output.attr("flags").attr("writeable") = false;
+  return output;
+}
+
+// Python object keeping grids that outlive the manager's cache alive
+py::capsule sharedOwner(std::shared_ptr<const SurfaceTask::GridArray> grids) {
+  using SharedGrids = std::shared_ptr<const SurfaceTask::GridArray>;
+  return py::capsule{new SharedGrids{std::move(grids)}, [](void* const ptr) {
+                       delete static_cast<SharedGrids*>(ptr);
+                     }};
+}
+
+// Whether Python objects can still be touched from a pricing thread (the
+// interpreter may be shutting down when a submission finishes)
+bool pythonAlive() {
+#if PY_VERSION_HEX >= 0x030D0000
+  return Py_IsInitialized() != 0 && Py_IsFinalizing() == 0;
+#else
+  return Py_IsInitialized() != 0 && _Py_IsFinalizing() == 0;
+#endif
+}
+
+// concurrent.futures.Future resolved with one greek's arrays (as returned by
+// get_greek) once `task` is finished; the arrays own the task's grids so they
+// don't depend on what the cache holds later
+py::object greekFuture(const std::shared_ptr<SurfaceTask>& task,
+                       const Enums::GreekType greekType) {
+  py::object future{
+      py::module_::import("concurrent.futures").attr("Future")()};
+
+  // Pricing can't be cancelled once submitted
+  future.attr("set_running_or_notify_cancel")();
+
+  // The callback usually runs on the pricing thread, so the future is only
+  // touched (and released) with the GIL held
+  const std::shared_ptr<py::object> target{
+      new py::object{future}, [](py::object* const ptr) {
+        if (pythonAlive()) {
+          py::gil_scoped_acquire gil{};
+          delete ptr;
+        }
+      }};
+
+  task->onDone([target, greekType](const SurfaceTask& done) {
+    if (!pythonAlive()) {
+      return;
+    }
+
+    py::gil_scoped_acquire gil{};
+
+    // Callbacks can't throw, and a future that refuses the outcome has nobody
+    // left to report to
+    try {
+      std::shared_ptr<const SurfaceTask::GridArray> grids{};
+
+      try {
+        grids = done.grids();
+      } catch (const std::invalid_argument& e) {
+        target->attr("set_exception")(py::handle{PyExc_ValueError}(e.what()));
+        return;
+      } catch (const std::exception& e) {
+        target->attr("set_exception")(
+            py::handle{PyExc_RuntimeError}(e.what()));
+        return;
+      }
+
+      const py::tuple arrays{
+          greekViews(grids->view(), greekType, sharedOwner(grids))};
+      target->attr("set_result")(arrays);
+    } catch (const std::exception&) {
+    }
+  });
+
+  return future;
+}
+
+// Inputs of one surface in a get_many request or a warm-up list (a dict of
+// get_greek's keyword arguments, or of get_greek_axes' with explicit sigmas and
+// strikes)
+SurfaceSpec parseRequest(const py::dict& request) {
+  const auto spacing{[&](const char* const key) {
+    return request.contains(key) ? request[key].cast<Enums::AxisSpacing>()
+                                 : Enums::AxisSpacing::Linear;
+  }};
+  const auto axis{[&](const char* const points, const char* const size,
+                      const char* const lo, const char* const hi,
+                      const char* const spacingKey) {
+    if (request.contains(points)) {
+      return request[points].cast<Eigen::ArrayXd>();
+    }
+
+    return makeAxis(spacing(spacingKey), request[size].cast<Eigen::Index>(),
+                    request[lo].cast<double>(), request[hi].cast<double>());
+  }};
+
+  return SurfaceSpec{
+      .sigmas_ = axis("sigmas", "n_sigma", "sigma_lo", "sigma_hi",
+                      "sigma_spacing"),
+      .strikes_ = axis("strikes", "n_strike", "strike_lo", "strike_hi",
+                       "strike_spacing"),
+      .spot_ = request["spot"].cast<double>(),
+      .r_ = request["r"].cast<double>(),
+      .q_ = request["q"].cast<double>(),
+      .tau_ = request["tau"].cast<double>()};
+}
+
+// One position of a revalued book (a dict with option_type, strike, tau and
+// quantity)
+Portfolio::Position parsePosition(const py::dict& position) {
+  return Portfolio::Position{
+      .optType_ = position["option_type"].cast<Enums::OptionType>(),
+      .strike_ = position["strike"].cast<double>(),
+      .tau_ = position["tau"].cast<double>(),
+      .quantity_ = position["quantity"].cast<double>()};
+}
+
+// Retrieve one greek for every option type as read-only numpy views of the
+// manager's grids
+py::tuple greekArrays(OptionsManager& manager, const Enums::GreekType greekType,
+                      const Eigen::ArrayXd& sigmas,
+                      const Eigen::ArrayXd& strikes, const double spot,
+                      const double r, const double q, const double tau) {
+  // Release GIL for multithreaded evaluation
+  py::gil_scoped_release noGil{};
+
+  // Get a view of the cached block (this points straight into the
+  // shared-memory mapping when a shared cache is in use)
+  const GridBlock::View block{
+      manager.getBlock(sigmas, strikes, spot, r, q, tau)};
+
+  // Re-acquire the GIL
+  py::gil_scoped_acquire gil{};
+
+  // The manager object owns the memory (or the mapping of it)
+  return greekViews(block, greekType, py::cast(&manager));
+}
+
+// Retrieve every grid as one read-only 4-D numpy view of the manager's block
+py::array blockArray(OptionsManager& manager, const Eigen::ArrayXd& sigmas,
+                     const Eigen::ArrayXd& strikes, const double spot,
+                     const double r, const double q, const double tau) {
+  GridBlock::View block{};
+
+  {
+    py::gil_scoped_release noGil{};
+    block = manager.getBlock(sigmas, strikes, spot, r, q, tau);
+  }
+
+  return blockView(block, py::cast(&manager));
+}
+
+// One greek of every option type encoded into new (column-major) numpy
+// arrays by `encode(grid, out)`
+template <typename T, typename Encode>
+py::tuple encodedArrays(const GridBlock::View& block,
+                        const Enums::GreekType greekType,
+                        const Encode& encode) {
+  const auto greekIdx{static_cast<py::ssize_t>(Enums::idx(greekType))};
+  py::tuple output{nOptTypes};
+
+  for (py::ssize_t optIdx{0}; optIdx < nOptTypes; ++optIdx) {
+    const GridBlock::ConstGrid grid{
+        block.grid(static_cast<std::size_t>(optIdx * nGreeks + greekIdx))};
+    py::array_t<T, py::array::f_style> array{{grid.rows(), grid.cols()}};
+    encode(grid, array.mutable_data());
+    output[static_cast<std::size_t>(optIdx)] = std::move(array);
+  }
+
+  return output;
+}
+
+// One greek of every option type for the heatmaps as (arrays, (z_min, z_max),
+// (offset, scale)): the color range the option types share and their grids in
+// the requested encoding (offset and scale are None unless the arrays hold
+// integer codes)
+py::tuple heatmapPayload(OptionsManager& manager,
+                         const Enums::GreekType greekType,
+                         const Eigen::ArrayXd& sigmas,
+                         const Eigen::ArrayXd& strikes, const double spot,
+                         const double r, const double q, const double tau,
+                         const Enums::HeatmapEncoding encoding) {
+  GridBlock::View block{};
+
+  {
+    py::gil_scoped_release noGil{};
+    block = manager.getBlock(sigmas, strikes, spot, r, q, tau);
+  }
+
+  const heatmap::Range range{heatmap::greekRange(block, greekType)};
+  const py::tuple zRange{py::make_tuple(range.min_, range.max_)};
+
+  // Codes of either width over the shared range
+  const auto quantized{[&]<typename Code>() {
+    const heatmap::Quantization codes{heatmap::quantization<Code>(range)};
+    return py::make_tuple(
+        encodedArrays<Code>(block, greekType,
+                            [&codes](const GridBlock::ConstGrid& grid,
+                                     Code* const out) {
+                              heatmap::quantize(grid, codes, out);
+                            }),
+        zRange, py::make_tuple(codes.offset_, codes.scale_));
+  }};
+
+  switch (encoding) {
+    case Enums::HeatmapEncoding::Float32:
+      return py::make_tuple(
+          encodedArrays<float>(block, greekType, &heatmap::narrow), zRange,
+          py::none());
+
+    case Enums::HeatmapEncoding::UInt16:
+      return quantized.operator()<std::uint16_t>();
+
+    case Enums::HeatmapEncoding::UInt8:
+      return quantized.operator()<std::uint8_t>();
+
+    case Enums::HeatmapEncoding::Float64:
+      break;
+  }
+
+  // The manager object owns the memory (or the mapping of it)
+  return py::make_tuple(greekViews(block, greekType, py::cast(&manager)),
+                        zRange, py::none());
+}
+
+// Every grid at several maturities as one (option type, greek, tau, sigma,
+// strike) numpy array (copied, since each maturity is its own block)
+py::array cubeArray(OptionsManager& manager, const Eigen::ArrayXd& sigmas,
+                    const Eigen::ArrayXd& strikes, const double spot,
+                    const double r, const double q,
+                    const Eigen::ArrayXd& taus) {
+  std::vector<GridBlock> cube{};
+
+  {
+    py::gil_scoped_release noGil{};
+    cube = manager.getCube(sigmas, strikes, spot, r, q, taus);
+  }
+
+  const auto nTaus{static_cast<py::ssize_t>(taus.size())};
+  const auto nSigma{static_cast<py::ssize_t>(sigmas.size())};
+  const auto nStrike{static_cast<py::ssize_t>(strikes.size())};
+  const py::ssize_t nCells{nSigma * nStrike};
+  const py::ssize_t gridBytes{szDbl * nCells};
+  py::array_t<double> output{
+      // Shape
+      {nOptTypes, nGreeks, nTaus, nSigma, nStrike},
+      // Strides (grids are column-major like get_all's, without the padding)
+      {gridBytes * nTaus * nGreeks, gridBytes * nTaus, gridBytes, szDbl,
+       szDbl * nSigma}};
+  double* const out{output.mutable_data()};
+
+  for (py::ssize_t tauIdx{0}; tauIdx < nTaus; ++tauIdx) {
+    const GridBlock& block{cube[static_cast<std::size_t>(tauIdx)]};
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      const GridBlock::ConstGrid grid{block[idx]};
+      const auto gridIdx{static_cast<py::ssize_t>(idx)};
+      std::copy_n(grid.data(), nCells,
+                  out + (gridIdx * nTaus + tauIdx) * nCells);
+    }
+  }
+
+  return output;
+}
+
+// Book P&L (spot shock x vol shock) and greek totals (greek, spot shock, vol
+// shock) over a shock grid as numpy arrays
+py::tuple scenarioArrays(OptionsManager& manager, const py::list& positions,
+                         const double spot, const double r, const double q,
+                         const double sigma, const Eigen::ArrayXd& spotShocks,
+                         const Eigen::ArrayXd& volShocks) {
+  std::vector<Portfolio::Position> book{};
+
+  for (const py::handle position : positions) {
+    book.push_back(parsePosition(position.cast<py::dict>()));
+  }
+
+  Portfolio::Scenarios scenarios{};
+
+  {
+    py::gil_scoped_release noGil{};
+    scenarios =
+        manager.revalue(book, spot, r, q, sigma, spotShocks, volShocks);
+  }
+
+  const auto nSpot{static_cast<py::ssize_t>(spotShocks.size())};
+  const auto nVol{static_cast<py::ssize_t>(volShocks.size())};
+  const py::ssize_t nCells{nSpot * nVol};
+  py::array_t<double> totals{
+      // Shape
+      {nGreeks, nSpot, nVol},
+      // Strides (column-major scenario grids like the P&L's)
+      {szDbl * nCells, szDbl, szDbl * nSpot}};
+  double* const out{totals.mutable_data()};
+
+  for (std::size_t greekIdx{0}; greekIdx < Portfolio::nGreeks; ++greekIdx) {
+    std::copy_n(scenarios.totals_[greekIdx].data(), nCells,
+                out + static_cast<py::ssize_t>(greekIdx) * nCells);
+  }
+
+  return py::make_tuple(std::move(scenarios.pnl_), std::move(totals));
+}
+
+// Latest refinement stage of a progressively computed surface as (version,
+// final, arrays) where arrays is None until the first stage is ready
+py::tuple greekProgress(OptionsManager& manager,
+                        const Enums::GreekType greekType,
+                        const Eigen::ArrayXd& sigmas,
+                        const Eigen::ArrayXd& strikes, const double spot,
+                        const double r, const double q, const double tau) {
+  using Stage = ProgressiveSurface::Stage;
+  OptionsManager::Progress progress{};
+
+  {
+    py::gil_scoped_release noGil{};
+    progress = manager.getProgressive(sigmas, strikes, spot, r, q, tau);
+  }
+
+  const bool final{progress.stage_ == Stage::Final};
+  py::object arrays{py::none()};
+
+  if (progress.grids_ != nullptr) {
+    // Intermediate stages are kept alive by the arrays themselves (the next
+    // stage replaces them in the manager), final ones are owned by the cache
+    const py::object owner{progress.owner_
+                               ? py::object{sharedOwner(progress.owner_)}
+                               : py::cast(&manager)};
+    arrays = greekViews(progress.grids_->view(), greekType, owner);
+  }
+
+  return py::make_tuple(static_cast<int>(progress.stage_), final, arrays);
+}
+
+}  // namespace
+
 PYBIND11_MODULE(CppPricingEngine, m) {
   // --- OptionsManager class
   py::class_<OptionsManager> pyOptionsManager{m, "OptionsManager"};
 
-  // Exposed Constructors (first uses all available threads)
-  pyOptionsManager.def(py::init<std::size_t>(), py::arg("capacity"));
-  pyOptionsManager.def(py::init<std::size_t, std::size_t>(),
-                       py::arg("capacity"), py::arg("n_threads"));
+  // Exposed Constructor (n_threads=0 uses all available threads; cold_capacity
+  // keeps that many evicted entries compressed; truncation limits the American
+  // trees to that many standard deviations around spot, 0 for the full
+  // lattice; control_variate corrects them with the European tree's error
+  // against BSM; preview_stride and preview_depth shape the progressive
+  // previews; a shared_cache name shares results with other processes through
+  // shared memory; coalesce_ms batches submissions of the same underlying;
+  // warmup is a list of get_many-style requests priced in the background at
+  // low priority right away; affinity pins the pool threads to cores or NUMA
+  // nodes and partitions splits large surfaces into that many blocks of strike
+  // columns, 0 for one per NUMA node)
+  pyOptionsManager.def(
+      py::init([](const std::size_t capacity, const std::size_t nThreads,
+                  const Enums::CachePolicy cachePolicy,
+                  const std::size_t coldCapacity, const double coldTolerance,
+                  const Eigen::Index treeDepth, const double truncation,
+                  const bool controlVariate, const Eigen::Index previewStride,
+                  const Eigen::Index previewDepth,
+                  const std::optional<std::string>& sharedCache,
+                  const std::size_t sharedCapacity, const double coalesceMs,
+                  const py::list& warmup, const Enums::ThreadAffinity affinity,
+                  const Eigen::Index partitions) {
+        std::vector<SurfaceSpec> surfaces{};
+
+        for (const py::handle request : warmup) {
+          surfaces.push_back(parseRequest(request.cast<py::dict>()));
+        }
 
-  // Method to retrieve greeks values
+        return std::make_unique<OptionsManager>(
+            ManagerConfig{.capacity_ = capacity,
+                          .nThreads_ = nThreads,
+                          .affinity_ = affinity,
+                          .cachePolicy_ = cachePolicy,
+                          .tree_ = {.depth_ = treeDepth,
+                                    .truncation_ = truncation,
+                                    .controlVariate_ = controlVariate,
+                                    .partitions_ = partitions},
+                          .coldCapacity_ = coldCapacity,
+                          .coldTolerance_ = coldTolerance,
+                          .previewStride_ = previewStride,
+                          .previewDepth_ = previewDepth,
+                          .coalesceMs_ = coalesceMs,
+                          .warmup_ = std::move(surfaces),
+                          .sharedCache_ = sharedCache.value_or(""),
+                          .sharedCapacity_ = sharedCapacity});
+      }),
+      py::arg("capacity"), py::arg("n_threads") = 0,
+      py::arg("cache_policy") = Enums::CachePolicy::LRU,
+      py::arg("cold_capacity") = 0, py::arg("cold_tolerance") = 1e-4,
+      py::arg("tree_depth") = models::trinomial::defaultDepth,
+      py::arg("truncation") = 0.0, py::arg("control_variate") = false,
+      py::arg("preview_stride") = 4, py::arg("preview_depth") = 25,
+      py::arg("shared_cache") = py::none(), py::arg("shared_capacity") = 64,
+      py::arg("coalesce_ms") = 0.0, py::arg("warmup") = py::list{},
+      py::arg("affinity") = Enums::ThreadAffinity::Off,
+      py::arg("partitions") = 1);
+
+  // Hit/miss counters of the in-process cache (for comparing cache policies)
+  pyOptionsManager.def("cache_stats", [](const OptionsManager& manager) {
+    const CacheStats stats{manager.cacheStats()};
+    py::dict output{};
+    output["hits"] = stats.hits_;
+    output["misses"] = stats.misses_;
+    output["evictions"] = stats.evictions_;
+    output["rejections"] = stats.rejections_;
+    output["cold_hits"] = stats.coldHits_;
+    output["hit_rate"] = stats.hitRate();
+    return output;
+  });
+  pyOptionsManager.def("reset_cache_stats", &OptionsManager::resetCacheStats);
+
+  // Method to retrieve greeks values (axes are linearly spaced unless another
+  // spacing is requested)
   pyOptionsManager.def(
       "get_greek",
       [](OptionsManager& manager, const Enums::GreekType greekType,
          const Eigen::Index nSigma, const Eigen::Index nStrike,
          const double spot, const double r, const double q,
          const double sigmaLo, const double sigmaHi, const double strikeLo,
-         const double strikeHi, const double tau) {
-        // Release GIL for multithreaded evaluation
-        py::gil_scoped_release noGil{};
-
-        // Get the reference to the array in the cache
-        const auto& grids{manager.get(nSigma, nStrike, spot, r, q, sigmaLo,
-                                      sigmaHi, strikeLo, strikeHi, tau)};
-
-        // Re-acquire the GIL
-        py::gil_scoped_acquire gil{};
-
-        // Pass immuatable views of data to python
-        static constexpr std::size_t nGreeks{
-            Enums::idx(Enums::GreekType::COUNT)};
-        static constexpr std::size_t nOptTypes{
-            Enums::idx(Enums::OptionType::COUNT)};
-        const std::size_t greekIdx{Enums::idx(greekType)};
-        py::tuple output{nOptTypes};
-
-        for (std::size_t optIdx{0}; optIdx < nOptTypes; ++optIdx) {
-          const auto& grid{grids[optIdx * nGreeks + greekIdx]};
-
-          // Strides are defined for column-major order
-          static_assert(!std::decay_t<decltype(grid)>::IsRowMajor,
-                        "Strides are defined for column-major storage order.");
-          constexpr py::ssize_t szDbl{sizeof(double)};
-
-          // Map an Eigen array to a numpy array without copying the underlying
-          // data
-          output[optIdx] = py::array{
-              // Shape
-              {grid.rows(), grid.cols()},
-              // Strides (defined for column major order)
-              {
-                  szDbl,                      // distance to next row
-                  szDbl * grid.outerStride()  // distance to next column
-              },
-              // Data pointer
-              grid.data(),
-              // Owner/handle (tells python not to delete this memory when the
-              // array goes out of scope since the manager object owns it)
-              py::cast(&manager)};
-
-          // Don't allow the object to be writeable in python
-          output[optIdx].attr("flags").attr("writeable") = false;
+         const double strikeHi, const double tau,
+         const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        return greekArrays(manager, greekType, sigmas, strikes, spot, r, q,
+                           tau);
+      },
+      py::arg("greek_type"), py::arg("n_sigma"), py::arg("n_strike"),
+      py::arg("spot"), py::arg("r"), py::arg("q"), py::arg("sigma_lo"),
+      py::arg("sigma_hi"), py::arg("strike_lo"), py::arg("strike_hi"),
+      py::arg("tau"), py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear);
+
+  // Progressive variant of get_greek: returns (version, final, arrays) right
+  // away while the surface is refined from a coarse preview in the background
+  // (poll again until final is True; arrays is None until the preview is ready)
+  pyOptionsManager.def(
+      "get_greek_progressive",
+      [](OptionsManager& manager, const Enums::GreekType greekType,
+         const Eigen::Index nSigma, const Eigen::Index nStrike,
+         const double spot, const double r, const double q,
+         const double sigmaLo, const double sigmaHi, const double strikeLo,
+         const double strikeHi, const double tau,
+         const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        return greekProgress(manager, greekType, sigmas, strikes, spot, r, q,
+                             tau);
+      },
+      py::arg("greek_type"), py::arg("n_sigma"), py::arg("n_strike"),
+      py::arg("spot"), py::arg("r"), py::arg("q"), py::arg("sigma_lo"),
+      py::arg("sigma_hi"), py::arg("strike_lo"), py::arg("strike_hi"),
+      py::arg("tau"), py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear);
+
+  // Method to retrieve greeks values over explicit sigma and strike axes
+  pyOptionsManager.def("get_greek_axes", &greekArrays, py::arg("greek_type"),
+                       py::arg("sigmas"), py::arg("strikes"), py::arg("spot"),
+                       py::arg("r"), py::arg("q"), py::arg("tau"));
+
+  // Method to retrieve every greek of every option type at once as a single
+  // read-only array shaped (option type, greek, sigma, strike), without
+  // copying (index it with the OptionType and GreekType values)
+  pyOptionsManager.def(
+      "get_all",
+      [](OptionsManager& manager, const Eigen::Index nSigma,
+         const Eigen::Index nStrike, const double spot, const double r,
+         const double q, const double sigmaLo, const double sigmaHi,
+         const double strikeLo, const double strikeHi, const double tau,
+         const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        return blockArray(manager, sigmas, strikes, spot, r, q, tau);
+      },
+      py::arg("n_sigma"), py::arg("n_strike"), py::arg("spot"), py::arg("r"),
+      py::arg("q"), py::arg("sigma_lo"), py::arg("sigma_hi"),
+      py::arg("strike_lo"), py::arg("strike_hi"), py::arg("tau"),
+      py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear);
+
+  pyOptionsManager.def("get_all_axes", &blockArray, py::arg("sigmas"),
+                       py::arg("strikes"), py::arg("spot"), py::arg("r"),
+                       py::arg("q"), py::arg("tau"));
+
+  // Method to retrieve one greek for the heatmaps together with the color range
+  // shared by the option types (computed by the engine), optionally as float32
+  // values or uint16/uint8 codes that decode to offset + scale * code (the
+  // largest code marks values that aren't finite)
+  pyOptionsManager.def(
+      "get_heatmap",
+      [](OptionsManager& manager, const Enums::GreekType greekType,
+         const Eigen::Index nSigma, const Eigen::Index nStrike,
+         const double spot, const double r, const double q,
+         const double sigmaLo, const double sigmaHi, const double strikeLo,
+         const double strikeHi, const double tau,
+         const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing,
+         const Enums::HeatmapEncoding encoding) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        return heatmapPayload(manager, greekType, sigmas, strikes, spot, r, q,
+                              tau, encoding);
+      },
+      py::arg("greek_type"), py::arg("n_sigma"), py::arg("n_strike"),
+      py::arg("spot"), py::arg("r"), py::arg("q"), py::arg("sigma_lo"),
+      py::arg("sigma_hi"), py::arg("strike_lo"), py::arg("strike_hi"),
+      py::arg("tau"), py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("encoding") = Enums::HeatmapEncoding::Float64);
+
+  // Method to retrieve every greek of every option type at several maturities
+  // as one array shaped (option type, greek, tau, sigma, strike); maturities
+  // that aren't cached are priced together
+  pyOptionsManager.def(
+      "get_cube",
+      [](OptionsManager& manager, const Eigen::Index nSigma,
+         const Eigen::Index nStrike, const double spot, const double r,
+         const double q, const double sigmaLo, const double sigmaHi,
+         const double strikeLo, const double strikeHi,
+         const Eigen::ArrayXd& taus, const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        return cubeArray(manager, sigmas, strikes, spot, r, q, taus);
+      },
+      py::arg("n_sigma"), py::arg("n_strike"), py::arg("spot"), py::arg("r"),
+      py::arg("q"), py::arg("sigma_lo"), py::arg("sigma_hi"),
+      py::arg("strike_lo"), py::arg("strike_hi"), py::arg("taus"),
+      py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear);
+
+  pyOptionsManager.def("get_cube_axes", &cubeArray, py::arg("sigmas"),
+                       py::arg("strikes"), py::arg("spot"), py::arg("r"),
+                       py::arg("q"), py::arg("taus"));
+
+  // Revalue a book of positions (dicts with option_type, strike, tau and
+  // quantity) with spot scaled by 1 + each spot shock and each vol shock added
+  // to sigma; returns (pnl, totals) where totals is indexed by GreekType value
+  pyOptionsManager.def("revalue", &scenarioArrays, py::arg("positions"),
+                       py::arg("spot"), py::arg("r"), py::arg("q"),
+                       py::arg("sigma"), py::arg("spot_shocks"),
+                       py::arg("vol_shocks"));
+
+  // Asynchronous variant of get_greek: returns a concurrent.futures.Future
+  // right away and prices the surface in the background (the result is the
+  // same tuple of arrays; await it with asyncio.wrap_future or
+  // concurrent.futures.wait without holding the GIL)
+  pyOptionsManager.def(
+      "submit",
+      [](OptionsManager& manager, const Enums::GreekType greekType,
+         const Eigen::Index nSigma, const Eigen::Index nStrike,
+         const double spot, const double r, const double q,
+         const double sigmaLo, const double sigmaHi, const double strikeLo,
+         const double strikeHi, const double tau,
+         const Enums::AxisSpacing sigmaSpacing,
+         const Enums::AxisSpacing strikeSpacing) {
+        const Eigen::ArrayXd sigmas{
+            makeAxis(sigmaSpacing, nSigma, sigmaLo, sigmaHi)};
+        const Eigen::ArrayXd strikes{
+            makeAxis(strikeSpacing, nStrike, strikeLo, strikeHi)};
+        std::shared_ptr<SurfaceTask> task{};
+
+        {
+          py::gil_scoped_release noGil{};
+          task = manager.submit(sigmas, strikes, spot, r, q, tau);
         }
 
-        return output;
-      });
+        return greekFuture(task, greekType);
+      },
+      py::arg("greek_type"), py::arg("n_sigma"), py::arg("n_strike"),
+      py::arg("spot"), py::arg("r"), py::arg("q"), py::arg("sigma_lo"),
+      py::arg("sigma_hi"), py::arg("strike_lo"), py::arg("strike_hi"),
+      py::arg("tau"), py::arg("sigma_spacing") = Enums::AxisSpacing::Linear,
+      py::arg("strike_spacing") = Enums::AxisSpacing::Linear);
+
+  // Submit several surfaces at once (each request is a dict of get_greek's
+  // keyword arguments, or of get_greek_axes' with explicit sigmas and strikes)
+  // and return one future per request, in order; distinct surfaces are priced
+  // concurrently
+  pyOptionsManager.def(
+      "get_many",
+      [](OptionsManager& manager, const Enums::GreekType greekType,
+         const std::vector<py::dict>& requests) {
+        std::vector<SurfaceSpec> inputs{};
+        inputs.reserve(requests.size());
+
+        for (const py::dict& request : requests) {
+          inputs.push_back(parseRequest(request));
+        }
+
+        std::vector<std::shared_ptr<SurfaceTask>> tasks{};
+        tasks.reserve(inputs.size());
+
+        {
+          py::gil_scoped_release noGil{};
+
+          for (const SurfaceSpec& in : inputs) {
+            tasks.push_back(manager.submit(in.sigmas_, in.strikes_, in.spot_,
+                                           in.r_, in.q_, in.tau_));
+          }
+        }
+
+        py::list futures{};
+
+        for (const std::shared_ptr<SurfaceTask>& task : tasks) {
+          futures.append(greekFuture(task, greekType));
+        }
+
+        return futures;
+      },
+      py::arg("greek_type"), py::arg("requests"));
 
   // --- Enums
 
@@ -87,6 +723,9 @@ PYBIND11_MODULE(CppPricingEngine, m) {
       .value("Vega", Enums::GreekType::Vega)
       .value("Theta", Enums::GreekType::Theta)
       .value("Rho", Enums::GreekType::Rho)
+      .value("Vanna", Enums::GreekType::Vanna)
+      .value("Volga", Enums::GreekType::Volga)
+      .value("Charm", Enums::GreekType::Charm)
       .value("COUNT", Enums::GreekType::COUNT)
       .finalize();
 
@@ -100,9 +739,44 @@ PYBIND11_MODULE(CppPricingEngine, m) {
       .value("COUNT", Enums::OptionType::COUNT)
       .finalize();
 
+  // CachePolicy Enum
+  py::native_enum<Enums::CachePolicy>(pyOptionsManager, "CachePolicy",
+                                      "enum.Enum")
+      .value("LRU", Enums::CachePolicy::LRU)
+      .value("TinyLFU", Enums::CachePolicy::TinyLFU)
+      .finalize();
+
+  // ThreadAffinity Enum
+  py::native_enum<Enums::ThreadAffinity>(pyOptionsManager, "ThreadAffinity",
+                                         "enum.Enum")
+      .value("Off", Enums::ThreadAffinity::Off)
+      .value("Core", Enums::ThreadAffinity::Core)
+      .value("Node", Enums::ThreadAffinity::Node)
+      .finalize();
+
+  // HeatmapEncoding Enum
+  py::native_enum<Enums::HeatmapEncoding>(pyOptionsManager, "HeatmapEncoding",
+                                          "enum.Enum")
+      .value("Float64", Enums::HeatmapEncoding::Float64)
+      .value("Float32", Enums::HeatmapEncoding::Float32)
+      .value("UInt16", Enums::HeatmapEncoding::UInt16)
+      .value("UInt8", Enums::HeatmapEncoding::UInt8)
+      .finalize();
+
+  // AxisSpacing Enum
+  py::native_enum<Enums::AxisSpacing>(pyOptionsManager, "AxisSpacing",
+                                      "enum.Enum")
+      .value("Linear", Enums::AxisSpacing::Linear)
+      .value("Log", Enums::AxisSpacing::Log)
+      .value("Chebyshev", Enums::AxisSpacing::Chebyshev)
+      .finalize();
+
   // --- Helper functions
 
   // Generate coordinates
   m.def("linspace", &linspace, py::arg("size"), py::arg("lo"), py::arg("hi"),
         "Create a linearly spaced vector");
+  m.def("make_axis", &makeAxis, py::arg("spacing"), py::arg("size"),
+        py::arg("lo"), py::arg("hi"),
+        "Create an axis with the given spacing (as used by get_greek)");
 }
\ No newline at end of file
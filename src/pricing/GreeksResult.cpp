@@ -5,10 +5,15 @@
 
 GreeksResult::GreeksResult(Eigen::ArrayXXd&& price, Eigen::ArrayXXd&& delta,
                            Eigen::ArrayXXd&& gamma, Eigen::ArrayXXd&& vega,
-                           Eigen::ArrayXXd&& theta, Eigen::ArrayXXd&& rho)
+                           Eigen::ArrayXXd&& theta, Eigen::ArrayXXd&& rho,
+                           Eigen::ArrayXXd&& vanna, Eigen::ArrayXXd&& volga,
+                           Eigen::ArrayXXd&& charm)
     : price_{std::move(price)},
       delta_{std::move(delta)},
       gamma_{std::move(gamma)},
       vega_{std::move(vega)},
       theta_{std::move(theta)},
-      rho_{std::move(rho)} {}
+      rho_{std::move(rho)},
+      vanna_{std::move(vanna)},
+      volga_{std::move(volga)},
+      charm_{std::move(charm)} {}
@@ -0,0 +1,158 @@
+#include "OptionsVisualizer/pricing/Portfolio.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/GreeksResult.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/orchestrate.hpp"
+
+Portfolio::Portfolio(const std::vector<Position>& positions, const double spot,
+                     const double r, const double q, const double sigma,
+                     BS::priority_thread_pool& pool,
+                     const models::trinomial::TreeSettings& settings)
+    : expiries_{netPositions(positions)},
+      spot_{spot},
+      r_{r},
+      q_{q},
+      sigma_{sigma},
+      pool_{pool},
+      settings_{settings} {}
+
+std::vector<Portfolio::Expiry> Portfolio::netPositions(
+    const std::vector<Position>& positions) {
+  static constexpr std::size_t nOptTypes{
+      Enums::idx(Enums::OptionType::COUNT)};
+  using Quantities = std::array<double, nOptTypes>;
+
+  // Maturity -> strike -> signed quantity of each option type
+  std::map<double, std::map<double, Quantities>> book{};
+
+  for (const Position& position : positions) {
+    if (Enums::idx(position.optType_) >= nOptTypes) {
+      throw std::invalid_argument{"Unknown option type in position"};
+    }
+
+    if (!(position.strike_ > 0.0) || !(position.tau_ > 0.0)) {
+      throw std::invalid_argument{
+          "Position strikes and maturities must be positive"};
+    }
+
+    book[position.tau_][position.strike_][Enums::idx(position.optType_)] +=
+        position.quantity_;
+  }
+
+  std::vector<Expiry> expiries{};
+  expiries.reserve(book.size());
+
+  for (const auto& [tau, strikes] : book) {
+    const auto nStrikes{static_cast<Eigen::Index>(strikes.size())};
+    Expiry& expiry{expiries.emplace_back(
+        Expiry{.tau_ = tau,
+               .strikes_ = Eigen::ArrayXd(nStrikes),
+               .quantities_ = Eigen::ArrayXXd(
+                   nStrikes, static_cast<Eigen::Index>(nOptTypes))})};
+    Eigen::Index row{0};
+
+    for (const auto& [strike, quantities] : strikes) {
+      expiry.strikes_[row] = strike;
+
+      for (std::size_t optIdx{0}; optIdx < nOptTypes; ++optIdx) {
+        expiry.quantities_(row, static_cast<Eigen::Index>(optIdx)) =
+            quantities[optIdx];
+      }
+
+      ++row;
+    }
+  }
+
+  return expiries;
+}
+
+Portfolio::Scenarios Portfolio::revalue(const Eigen::ArrayXd& spotShocks,
+                                        const Eigen::ArrayXd& volShocks) const {
+  const Eigen::ArrayXd spots{spot_ * (1.0 + spotShocks)};
+  const Eigen::ArrayXd sigmas{sigma_ + volShocks};
+
+  if (!(spots > 0.0).all() || !(sigmas > 0.0).all()) {
+    throw std::invalid_argument{"Shocked spots and vols must stay positive"};
+  }
+
+  // The spot shocks (and the unshocked market the P&L is measured from, priced
+  // last) are orchestrated like TermStructure's maturities, each accumulating
+  // into its own totals
+  const Eigen::ArrayXd baseSigma{Eigen::ArrayXd::Constant(1, sigma_)};
+  const auto nSpots{static_cast<std::size_t>(spots.size())};
+  const std::vector<Eigen::ArrayXXd> results{orchestrate(
+      nSpots + 1, pool_.get_thread_count(), [&](const std::size_t idx) {
+        return idx < nSpots
+                   ? totals(spots[static_cast<Eigen::Index>(idx)], sigmas)
+                   : totals(spot_, baseSigma);
+      })};
+
+  Scenarios scenarios{};
+
+  for (Eigen::ArrayXXd& total : scenarios.totals_) {
+    total.resize(spots.size(), sigmas.size());
+  }
+
+  for (Eigen::Index row{0}; row < spots.size(); ++row) {
+    const Eigen::ArrayXXd& total{results[static_cast<std::size_t>(row)]};
+
+    for (std::size_t greekIdx{0}; greekIdx < nGreeks; ++greekIdx) {
+      scenarios.totals_[greekIdx].row(row) =
+          total.col(static_cast<Eigen::Index>(greekIdx)).transpose();
+    }
+  }
+
+  const double baseValue{results.back()(
+      0, static_cast<Eigen::Index>(Enums::idx(Enums::GreekType::Price)))};
+  scenarios.pnl_ =
+      scenarios.totals_[Enums::idx(Enums::GreekType::Price)] - baseValue;
+  return scenarios;
+}
+
+Eigen::ArrayXXd Portfolio::totals(const double spot,
+                                  const Eigen::ArrayXd& sigmas) const {
+  Eigen::ArrayXXd total{
+      Eigen::ArrayXXd::Zero(sigmas.size(), static_cast<Eigen::Index>(nGreeks))};
+
+  for (const Expiry& expiry : expiries_) {
+    const PricingSurface surface{sigmas, expiry.strikes_, spot,  r_,
+                                 q_,     expiry.tau_,     pool_, settings_};
+
+    // Only the option types held at this maturity are priced (European ones in
+    // closed form), and each type's greeks are weighted by its quantities at
+    // every strike and dropped before the next type is priced
+    for (Eigen::Index optIdx{0}; optIdx < expiry.quantities_.cols();
+         ++optIdx) {
+      const Eigen::VectorXd weights{expiry.quantities_.col(optIdx).matrix()};
+
+      if (weights.isZero(0.0)) {
+        continue;
+      }
+
+      const GreeksResult greeks{
+          surface.greeks(static_cast<Enums::OptionType>(optIdx))};
+      // In GreekType order
+      const std::array<const Eigen::ArrayXXd*, nGreeks> grids{
+          &greeks.price_, &greeks.delta_, &greeks.gamma_,
+          &greeks.vega_,  &greeks.theta_, &greeks.rho_,
+          &greeks.vanna_, &greeks.volga_, &greeks.charm_};
+
+      for (std::size_t greekIdx{0}; greekIdx < nGreeks; ++greekIdx) {
+        total.col(static_cast<Eigen::Index>(greekIdx)) +=
+            (grids[greekIdx]->matrix() * weights).array();
+      }
+    }
+  }
+
+  return total;
+}
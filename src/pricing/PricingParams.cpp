@@ -5,6 +5,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <vector>
+
+#include "OptionsVisualizer/core/linspace.hpp"
 
 PricingParams::PricingParams(const Eigen::Index nSigma,
                              const Eigen::Index nStrike, const double spot,
@@ -12,24 +15,50 @@ PricingParams::PricingParams(const Eigen::Index nSigma,
                              const double sigmaLo, const double sigmaHi,
                              const double strikeLo, const double strikeHi,
                              const double tau)
-    : data_{static_cast<std::int64_t>(nSigma),
-            static_cast<std::int64_t>(nStrike),
+    : PricingParams{linspace(nSigma, sigmaLo, sigmaHi),
+                    linspace(nStrike, strikeLo, strikeHi),
+                    spot,
+                    r,
+                    q,
+                    tau} {}
+
+PricingParams::PricingParams(const Eigen::ArrayXd& sigmas,
+                             const Eigen::ArrayXd& strikes, const double spot,
+                             const double r, const double q, const double tau)
+    : data_{static_cast<std::int64_t>(sigmas.size()),
+            static_cast<std::int64_t>(strikes.size()),
             quantize(spot),
             quantize(r),
             quantize(q),
-            quantize(sigmaLo),
-            quantize(sigmaHi),
-            quantize(strikeLo),
-            quantize(strikeHi),
-            quantize(tau)} {}
+            quantize(tau),
+            0,
+            0},
+      axes_{} {
+  axes_.reserve(static_cast<std::size_t>(sigmas.size() + strikes.size()));
+  data_[6] = appendAxis(sigmas);
+  data_[7] = appendAxis(strikes);
+}
 
 std::int64_t PricingParams::quantize(const double param) noexcept {
   static constexpr double scale{1e6};  // 1e-6 precision
   return static_cast<std::int64_t>(param * scale);
 }
 
+std::int64_t PricingParams::appendAxis(const Eigen::ArrayXd& axis) {
+  static constexpr std::hash<std::int64_t> hasher{};
+  std::size_t digest{0};
+
+  for (const double point : axis) {
+    const std::int64_t quantized{quantize(point)};
+    axes_.push_back(quantized);
+    PricingParamsHash::hashCombine(digest, hasher(quantized));
+  }
+
+  return static_cast<std::int64_t>(digest);
+}
+
 bool PricingParams::operator==(const PricingParams& other) const noexcept {
-  return data_ == other.data_;
+  return data_ == other.data_ && axes_ == other.axes_;
 }
 
 void PricingParamsHash::hashCombine(std::size_t& seed,
@@ -41,6 +70,7 @@ void PricingParamsHash::hashCombine(std::size_t& seed,
 
 std::size_t PricingParamsHash::operator()(
     const PricingParams& params) const noexcept {
+  // The axis digests already cover the axis contents
   static constexpr std::hash<std::int64_t> hasher{};
   std::size_t seed{0};
 
@@ -2,7 +2,10 @@
 
 #include <BS_thread_pool.hpp>
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
+#include <stdexcept>
+#include <utility>
 
 #include "OptionsVisualizer/core/Enums.hpp"
 #include "OptionsVisualizer/core/linspace.hpp"
@@ -13,42 +16,130 @@ PricingSurface::PricingSurface(const Eigen::Index nSigma,
                                const double r, const double q,
                                const double sigmaLo, const double sigmaHi,
                                const double strikeLo, const double strikeHi,
-                               const double tau, BS::thread_pool<>& pool)
-    : sigmasGrid_{linspace(nSigma, sigmaLo, sigmaHi).replicate(1, nStrike)},
-      strikesGrid_{linspace(nStrike, strikeLo, strikeHi)
-                       .transpose()
-                       .replicate(nSigma, 1)},
+                               const double tau, BS::priority_thread_pool& pool,
+                               const models::trinomial::TreeSettings& settings,
+                               const BS::priority_t priority)
+    : PricingSurface{linspace(nSigma, sigmaLo, sigmaHi),
+                     linspace(nStrike, strikeLo, strikeHi),
+                     spot,
+                     r,
+                     q,
+                     tau,
+                     pool,
+                     settings,
+                     priority} {}
+
+PricingSurface::PricingSurface(const Eigen::ArrayXd& sigmas,
+                               const Eigen::ArrayXd& strikes, const double spot,
+                               const double r, const double q,
+                               const double tau, BS::priority_thread_pool& pool,
+                               const models::trinomial::TreeSettings& settings,
+                               const BS::priority_t priority)
+    : sigmasGrid_{sigmas.replicate(1, strikes.size())},
+      strikesGrid_{strikes.transpose().replicate(sigmas.size(), 1)},
       spot_{spot},
       r_{r},
       q_{q},
       tau_{tau},
-      pool_{pool} {}
+      pool_{pool},
+      settings_{settings},
+      priority_{priority} {}
+
+PricingSurface::PricingSurface(Eigen::ArrayXXd sigmasGrid,
+                               Eigen::ArrayXXd strikesGrid, const double spot,
+                               const double r, const double q,
+                               const double tau, BS::priority_thread_pool& pool,
+                               const models::trinomial::TreeSettings& settings,
+                               const BS::priority_t priority)
+    : sigmasGrid_{std::move(sigmasGrid)},
+      strikesGrid_{std::move(strikesGrid)},
+      spot_{spot},
+      r_{r},
+      q_{q},
+      tau_{tau},
+      pool_{pool},
+      settings_{settings},
+      priority_{priority} {}
+
+PricingSurface PricingSurface::overCells(
+    const Eigen::ArrayXd& sigmas, const Eigen::ArrayXd& strikes,
+    const double spot, const double r, const double q, const double tau,
+    BS::priority_thread_pool& pool,
+    const models::trinomial::TreeSettings& settings) {
+  if (sigmas.size() != strikes.size()) {
+    throw std::invalid_argument{
+        "Every cell needs both a sigma and a strike"};
+  }
+
+  return PricingSurface{Eigen::ArrayXXd{sigmas},
+                        Eigen::ArrayXXd{strikes},
+                        spot,
+                        r,
+                        q,
+                        tau,
+                        pool,
+                        settings,
+                        BS::pr::normal};
+}
 
 void PricingSurface::appendGreeks(GridArray& grids,
                                   const Enums::OptionType optType,
-                                  GreeksResult&& g) {
+                                  const GreeksResult& g) {
   const std::size_t base{Enums::idx(optType) *
                          Enums::idx(Enums::GreekType::COUNT)};
-  grids[base + Enums::idx(Enums::GreekType::Price)] = std::move(g.price_);
-  grids[base + Enums::idx(Enums::GreekType::Delta)] = std::move(g.delta_);
-  grids[base + Enums::idx(Enums::GreekType::Gamma)] = std::move(g.gamma_);
-  grids[base + Enums::idx(Enums::GreekType::Vega)] = std::move(g.vega_);
-  grids[base + Enums::idx(Enums::GreekType::Theta)] = std::move(g.theta_);
-  grids[base + Enums::idx(Enums::GreekType::Rho)] = std::move(g.rho_);
+  grids[base + Enums::idx(Enums::GreekType::Price)] = g.price_;
+  grids[base + Enums::idx(Enums::GreekType::Delta)] = g.delta_;
+  grids[base + Enums::idx(Enums::GreekType::Gamma)] = g.gamma_;
+  grids[base + Enums::idx(Enums::GreekType::Vega)] = g.vega_;
+  grids[base + Enums::idx(Enums::GreekType::Theta)] = g.theta_;
+  grids[base + Enums::idx(Enums::GreekType::Rho)] = g.rho_;
+  grids[base + Enums::idx(Enums::GreekType::Vanna)] = g.vanna_;
+  grids[base + Enums::idx(Enums::GreekType::Volga)] = g.volga_;
+  grids[base + Enums::idx(Enums::GreekType::Charm)] = g.charm_;
 }
 
 PricingSurface::GridArray PricingSurface::calculateGrids() const {
+  return calculateGrids(bsmTerms());
+}
+
+PricingSurface::GridArray PricingSurface::calculateGrids(
+    const BsmTerms& terms) const {
   // Generate results
-  GreeksResult amerCall{trinomialGreeks<Enums::OptionType::AmerCall>()};
-  GreeksResult amerPut{trinomialGreeks<Enums::OptionType::AmerPut>()};
-  GreeksResult euroCall{bsmCallGreeks()};
-  GreeksResult euroPut{bsmPutGreeks(euroCall)};
-
-  // Move results to output array
-  GridArray grids{};
-  appendGreeks(grids, Enums::OptionType::AmerCall, std::move(amerCall));
-  appendGreeks(grids, Enums::OptionType::AmerPut, std::move(amerPut));
-  appendGreeks(grids, Enums::OptionType::EuroCall, std::move(euroCall));
-  appendGreeks(grids, Enums::OptionType::EuroPut, std::move(euroPut));
+  const GreeksResult amerCall{trinomialGreeks<Enums::OptionType::AmerCall>()};
+  const GreeksResult amerPut{trinomialGreeks<Enums::OptionType::AmerPut>()};
+  const GreeksResult euroCall{bsmCallGreeks(terms)};
+  const GreeksResult euroPut{bsmPutGreeks(euroCall)};
+
+  // Copy results into one contiguous block
+  GridArray grids{sigmasGrid_.rows(), sigmasGrid_.cols()};
+  appendGreeks(grids, Enums::OptionType::AmerCall, amerCall);
+  appendGreeks(grids, Enums::OptionType::AmerPut, amerPut);
+  appendGreeks(grids, Enums::OptionType::EuroCall, euroCall);
+  appendGreeks(grids, Enums::OptionType::EuroPut, euroPut);
   return grids;
 }
+
+GreeksResult PricingSurface::greeks(const Enums::OptionType optType) const {
+  switch (optType) {
+    case Enums::OptionType::AmerCall:
+      return trinomialGreeks<Enums::OptionType::AmerCall>();
+    case Enums::OptionType::AmerPut:
+      return trinomialGreeks<Enums::OptionType::AmerPut>();
+    case Enums::OptionType::EuroCall:
+      return bsmCallGreeks(bsmTerms());
+    case Enums::OptionType::EuroPut:
+      return bsmPutGreeks(bsmCallGreeks(bsmTerms()));
+    default:
+      throw std::invalid_argument{"Unknown option type"};
+  }
+}
+
+Eigen::Index PricingSurface::partitions() const noexcept {
+  // Smaller blocks cost more to schedule than they gain in parallelism
+  static constexpr Eigen::Index minBlockCells{64};
+  const Eigen::Index nCells{sigmasGrid_.size()};
+  const Eigen::Index nBlocks{std::min(settings_.partitions_,
+                                      nCells / minBlockCells)};
+  return std::clamp(nBlocks, Eigen::Index{1},
+                    std::max(sigmasGrid_.cols(), Eigen::Index{1}));
+}
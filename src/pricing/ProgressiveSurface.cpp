@@ -0,0 +1,222 @@
+#include "OptionsVisualizer/pricing/ProgressiveSurface.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+
+namespace {
+
+// Pair of coarse points bracketing a fine point: the fine value is
+// (1 - t) * coarse[lo] + t * coarse[lo + 1]
+struct Bracket {
+  Eigen::Index lo_;
+  double t_;
+};
+
+// Brackets of every point of a fine axis within a coarse axis covering the same
+// range (works for ascending and descending axes)
+[[nodiscard]] std::vector<Bracket> brackets(const Eigen::ArrayXd& coarse,
+                                            const Eigen::ArrayXd& fine) {
+  std::vector<Bracket> result(static_cast<std::size_t>(fine.size()),
+                              Bracket{.lo_ = 0, .t_ = 0.0});
+
+  if (coarse.size() < 2) {
+    return result;
+  }
+
+  Eigen::Index lo{0};
+
+  for (std::size_t idx{0}; idx < result.size(); ++idx) {
+    const double x{fine(static_cast<Eigen::Index>(idx))};
+
+    // Fine points are visited in axis order, so the bracket only moves forward
+    while (lo + 2 < coarse.size() &&
+           (x - coarse(lo + 1)) * (coarse(lo + 1) - coarse(lo)) > 0.0) {
+      ++lo;
+    }
+
+    const double span{coarse(lo + 1) - coarse(lo)};
+    result[idx] = Bracket{
+        .lo_ = lo,
+        .t_ = span == 0.0 ? 0.0
+                          : std::clamp((x - coarse(lo)) / span, 0.0, 1.0)};
+  }
+
+  return result;
+}
+
+// Blend two rows or columns (points that coincide with a coarse point copy it,
+// so a NaN in a neighbouring cell doesn't spread)
+template <typename Out, typename Lo, typename Hi>
+void blend(Out&& out, const Lo& lo, const Hi& hi, const double t) {
+  if (t == 0.0) {
+    out = lo;
+  } else if (t == 1.0) {
+    out = hi;
+  } else {
+    out = (1.0 - t) * lo + t * hi;
+  }
+}
+
+}  // namespace
+
+ProgressiveSurface::ProgressiveSurface(
+    Eigen::ArrayXd sigmas, Eigen::ArrayXd strikes, const double spot,
+    const double r, const double q, const double tau,
+    BS::priority_thread_pool& pool,
+    const models::trinomial::TreeSettings& settings, const Eigen::Index stride,
+    const Eigen::Index previewDepth)
+    : sigmas_{std::move(sigmas)},
+      strikes_{std::move(strikes)},
+      spot_{spot},
+      r_{r},
+      q_{q},
+      tau_{tau},
+      pool_{pool},
+      settings_{settings},
+      stride_{std::max(stride, Eigen::Index{1})},
+      previewDepth_{std::clamp(previewDepth, Eigen::Index{1}, settings.depth_)},
+      superseded_{false},
+      mutex_{},
+      latest_{},
+      stageSeconds_{0.0} {}
+
+void ProgressiveSurface::run() {
+  using Clock = std::chrono::steady_clock;
+  models::trinomial::TreeSettings shallow{settings_};
+  shallow.depth_ = previewDepth_;
+
+  // Intermediate stages overtake the final stages of other surfaces so the
+  // latest view shows up first
+  static constexpr BS::priority_t previewPriority{BS::pr::high};
+
+  // Preview over a strided subset of cells (skipped when striding wouldn't
+  // leave out any cell)
+  const Eigen::ArrayXd coarseSigmas{subsample(sigmas_, stride_)};
+  const Eigen::ArrayXd coarseStrikes{subsample(strikes_, stride_)};
+
+  if (superseded_.load()) {
+    return;
+  }
+
+  if (coarseSigmas.size() < sigmas_.size() ||
+      coarseStrikes.size() < strikes_.size()) {
+    const auto start{Clock::now()};
+    const PricingSurface surface{coarseSigmas, coarseStrikes, spot_,
+                                 r_,           q_,            tau_,
+                                 pool_,        shallow,       previewPriority};
+    const GridArray coarse{surface.calculateGrids()};
+    GridArray grids{sigmas_.size(), strikes_.size()};
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      grids[idx] = interpolate(coarse[idx], coarseSigmas, coarseStrikes,
+                               sigmas_, strikes_);
+    }
+
+    const std::chrono::duration<double> elapsed{Clock::now() - start};
+    publish(Stage::Preview, std::move(grids), elapsed.count());
+  }
+
+  if (superseded_.load()) {
+    return;
+  }
+
+  // Every cell on the shallow tree
+  if (previewDepth_ < settings_.depth_) {
+    const auto start{Clock::now()};
+    const PricingSurface surface{sigmas_, strikes_, spot_,   r_,
+                                 q_,      tau_,     pool_,   shallow,
+                                 previewPriority};
+    GridArray grids{surface.calculateGrids()};
+    const std::chrono::duration<double> elapsed{Clock::now() - start};
+    publish(Stage::Shallow, std::move(grids), elapsed.count());
+  }
+
+  if (superseded_.load()) {
+    return;
+  }
+
+  // Final surface
+  const auto start{Clock::now()};
+  const PricingSurface surface{sigmas_, strikes_, spot_, r_,
+                               q_,      tau_,     pool_, settings_};
+  GridArray grids{surface.calculateGrids()};
+  const std::chrono::duration<double> elapsed{Clock::now() - start};
+  publish(Stage::Final, std::move(grids), elapsed.count());
+}
+
+void ProgressiveSurface::supersede() noexcept { superseded_.store(true); }
+
+void ProgressiveSurface::resume() noexcept { superseded_.store(false); }
+
+ProgressiveSurface::Snapshot ProgressiveSurface::latest() const {
+  const std::lock_guard lock{mutex_};
+  return latest_;
+}
+
+double ProgressiveSurface::stageSeconds() const {
+  const std::lock_guard lock{mutex_};
+  return stageSeconds_;
+}
+
+void ProgressiveSurface::publish(const Stage stage, GridArray&& grids,
+                                 const double seconds) {
+  auto published{std::make_shared<const GridArray>(std::move(grids))};
+  const std::lock_guard lock{mutex_};
+  latest_ = Snapshot{.stage_ = stage, .grids_ = std::move(published)};
+  stageSeconds_ = seconds;
+}
+
+Eigen::ArrayXd ProgressiveSurface::subsample(const Eigen::ArrayXd& axis,
+                                             const Eigen::Index stride) {
+  if (axis.size() == 0) {
+    return axis;
+  }
+
+  const Eigen::Index last{axis.size() - 1};
+  const Eigen::Index nPoints{(last + stride - 1) / stride + 1};
+  Eigen::ArrayXd points{nPoints};
+
+  for (Eigen::Index idx{0}; idx < nPoints; ++idx) {
+    points(idx) = axis(std::min(idx * stride, last));
+  }
+
+  return points;
+}
+
+Eigen::ArrayXXd ProgressiveSurface::interpolate(
+    const GridBlock::ConstGrid& coarse, const Eigen::ArrayXd& coarseSigmas,
+    const Eigen::ArrayXd& coarseStrikes, const Eigen::ArrayXd& sigmas,
+    const Eigen::ArrayXd& strikes) {
+  // Rows along sigma first
+  const std::vector<Bracket> rowBrackets{brackets(coarseSigmas, sigmas)};
+  Eigen::ArrayXXd rows{sigmas.size(), coarse.cols()};
+
+  for (Eigen::Index row{0}; row < rows.rows(); ++row) {
+    const auto& [lo, t]{rowBrackets[static_cast<std::size_t>(row)]};
+    const Eigen::Index hi{std::min(lo + 1, coarse.rows() - 1)};
+    blend(rows.row(row), coarse.row(lo), coarse.row(hi), t);
+  }
+
+  // Then columns along strike
+  const std::vector<Bracket> colBrackets{brackets(coarseStrikes, strikes)};
+  Eigen::ArrayXXd grid{sigmas.size(), strikes.size()};
+
+  for (Eigen::Index col{0}; col < grid.cols(); ++col) {
+    const auto& [lo, t]{colBrackets[static_cast<std::size_t>(col)]};
+    const Eigen::Index hi{std::min(lo + 1, rows.cols() - 1)};
+    blend(grid.col(col), rows.col(lo), rows.col(hi), t);
+  }
+
+  return grid;
+}
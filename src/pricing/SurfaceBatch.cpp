@@ -0,0 +1,184 @@
+#include "OptionsVisualizer/pricing/SurfaceBatch.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+SurfaceBatch::SurfaceBatch(const double spot, const double r, const double q,
+                           const double tau,
+                           const std::chrono::duration<double> window,
+                           BS::priority_thread_pool& pool,
+                           const models::trinomial::TreeSettings& settings)
+    : spot_{spot},
+      r_{r},
+      q_{q},
+      tau_{tau},
+      window_{window},
+      pool_{pool},
+      settings_{settings},
+      mutex_{},
+      closed_{false},
+      members_{},
+      tasks_{} {}
+
+std::vector<SurfaceBatch::GridArray> SurfaceBatch::price(
+    const std::vector<Axes>& members, const double spot, const double r,
+    const double q, const double tau, BS::priority_thread_pool& pool,
+    const models::trinomial::TreeSettings& settings) {
+  // Cells are matched on their exact values (the bit patterns also give NaNs a
+  // well-defined order)
+  using Cell = std::pair<std::uint64_t, std::uint64_t>;
+  std::map<Cell, Eigen::Index> cellIdx{};
+  std::vector<double> cellSigmas{};
+  std::vector<double> cellStrikes{};
+
+  // Position of each member's cells (column-major like its grids) in the
+  // combined list of unique cells
+  std::vector<std::vector<Eigen::Index>> positions{};
+  positions.reserve(members.size());
+
+  for (const Axes& member : members) {
+    std::vector<Eigen::Index>& cells{positions.emplace_back()};
+    cells.reserve(static_cast<std::size_t>(member.sigmas_.size() *
+                                           member.strikes_.size()));
+
+    for (const double strike : member.strikes_) {
+      for (const double sigma : member.sigmas_) {
+        const auto [it, inserted]{cellIdx.try_emplace(
+            Cell{std::bit_cast<std::uint64_t>(sigma),
+                 std::bit_cast<std::uint64_t>(strike)},
+            static_cast<Eigen::Index>(cellSigmas.size()))};
+
+        if (inserted) {
+          cellSigmas.push_back(sigma);
+          cellStrikes.push_back(strike);
+        }
+
+        cells.push_back(it->second);
+      }
+    }
+  }
+
+  const auto nCells{static_cast<Eigen::Index>(cellSigmas.size())};
+  const PricingSurface surface{PricingSurface::overCells(
+      Eigen::Map<const Eigen::ArrayXd>{cellSigmas.data(), nCells},
+      Eigen::Map<const Eigen::ArrayXd>{cellStrikes.data(), nCells}, spot, r, q,
+      tau, pool, settings)};
+  const GridArray combined{surface.calculateGrids()};
+
+  // Scatter the combined results back into each member's grids
+  std::vector<GridArray> grids{};
+  grids.reserve(members.size());
+
+  for (std::size_t member{0}; member < members.size(); ++member) {
+    GridArray& out{grids.emplace_back(members[member].sigmas_.size(),
+                                      members[member].strikes_.size())};
+    const std::vector<Eigen::Index>& cells{positions[member]};
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      const GridBlock::ConstGrid src{std::as_const(combined)[idx]};
+      GridBlock::Grid dst{out[idx]};
+
+      for (std::size_t cell{0}; cell < cells.size(); ++cell) {
+        dst.data()[cell] = src.data()[cells[cell]];
+      }
+    }
+  }
+
+  return grids;
+}
+
+bool SurfaceBatch::matches(const double spot, const double r, const double q,
+                           const double tau) const noexcept {
+  return spot == spot_ && r == r_ && q == q_ && tau == tau_;
+}
+
+std::shared_ptr<SurfaceTask> SurfaceBatch::join(Eigen::ArrayXd sigmas,
+                                                Eigen::ArrayXd strikes) {
+  const std::lock_guard lock{mutex_};
+
+  if (closed_) {
+    return nullptr;
+  }
+
+  // The window starts with the first surface
+  if (members_.empty()) {
+    std::thread{[batch = shared_from_this()] {
+      std::this_thread::sleep_for(batch->window_);
+      batch->run();
+    }}.detach();
+  }
+
+  members_.push_back(
+      Axes{.sigmas_ = std::move(sigmas), .strikes_ = std::move(strikes)});
+  return tasks_.emplace_back(std::make_shared<SurfaceTask>());
+}
+
+bool SurfaceBatch::closed() const {
+  const std::lock_guard lock{mutex_};
+  return closed_;
+}
+
+void SurfaceBatch::run() {
+  std::vector<Axes> members{};
+  std::vector<std::shared_ptr<SurfaceTask>> tasks{};
+
+  {
+    const std::lock_guard lock{mutex_};
+    closed_ = true;
+    members.swap(members_);
+    tasks.swap(tasks_);
+  }
+
+  std::vector<GridArray> grids{};
+  std::exception_ptr error{};
+  const auto start{std::chrono::steady_clock::now()};
+
+  // The pool isn't used past this block (see SurfaceTask::price)
+  try {
+    grids = price(members, spot_, r_, q_, tau_, pool_, settings_);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+
+  // Each surface is charged its share of the cells (what the cache weighs as
+  // its cost to recompute)
+  const auto size{[](const Axes& member) {
+    return static_cast<double>(member.sigmas_.size() * member.strikes_.size());
+  }};
+  double nCells{0.0};
+
+  for (const Axes& member : members) {
+    nCells += size(member);
+  }
+
+  for (std::size_t idx{0}; idx < tasks.size(); ++idx) {
+    const double share{nCells > 0.0 ? size(members[idx]) / nCells : 0.0};
+    std::shared_ptr<const GridArray> result{};
+
+    if (!error) {
+      result = std::make_shared<const GridArray>(std::move(grids[idx]));
+    }
+
+    tasks[idx]->finish(std::move(result), error, elapsed.count() * share);
+  }
+}
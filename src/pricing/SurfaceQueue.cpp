@@ -0,0 +1,74 @@
+#include "OptionsVisualizer/pricing/SurfaceQueue.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+SurfaceQueue::SurfaceQueue(BS::priority_thread_pool& pool,
+                           const models::trinomial::TreeSettings& settings,
+                           const std::size_t maxThreads)
+    : mutex_{},
+      pending_{},
+      queue_{},
+      idle_{0},
+      stopping_{false},
+      pool_{pool},
+      settings_{settings},
+      maxThreads_{std::max(maxThreads, std::size_t{1})},
+      threads_{} {}
+
+SurfaceQueue::~SurfaceQueue() {
+  {
+    const std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+
+  pending_.notify_all();
+  threads_.clear();  // join
+}
+
+std::shared_ptr<SurfaceTask> SurfaceQueue::push(SurfaceSpec surface) {
+  auto task{std::make_shared<SurfaceTask>()};
+
+  {
+    const std::lock_guard lock{mutex_};
+    queue_.emplace_back(std::move(surface), task);
+
+    // Another thread only helps if every running one is busy
+    if (idle_ == 0 && threads_.size() < maxThreads_) {
+      threads_.emplace_back([this] { work(); });
+    }
+  }
+
+  pending_.notify_one();
+  return task;
+}
+
+void SurfaceQueue::work() {
+  std::unique_lock lock{mutex_};
+
+  while (true) {
+    ++idle_;
+    pending_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    --idle_;
+
+    if (queue_.empty()) {
+      return;  // stopping
+    }
+
+    auto [surface, task]{std::move(queue_.front())};
+    queue_.pop_front();
+
+    // The task is finished with the failure if pricing throws
+    lock.unlock();
+    task->price(surface, pool_, settings_, BS::pr::normal);
+    lock.lock();
+  }
+}
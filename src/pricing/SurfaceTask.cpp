@@ -0,0 +1,184 @@
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+
+SurfaceTask::SurfaceTask()
+    : mutex_{},
+      finished_{},
+      started_{false},
+      done_{false},
+      grids_{},
+      error_{},
+      seconds_{0.0},
+      callbacks_{} {}
+
+SurfaceTask::SurfaceTask(GridArray grids)
+    : mutex_{},
+      finished_{},
+      started_{true},
+      done_{true},
+      grids_{std::make_shared<const GridArray>(std::move(grids))},
+      error_{},
+      seconds_{0.0},
+      callbacks_{} {}
+
+std::vector<std::shared_ptr<SurfaceTask>> SurfaceTask::startSequence(
+    std::vector<SurfaceSpec> surfaces, BS::priority_thread_pool& pool,
+    const models::trinomial::TreeSettings& settings,
+    const BS::priority_t priority,
+    std::shared_ptr<const std::atomic<bool>> cancelled) {
+  std::vector<std::shared_ptr<SurfaceTask>> tasks{};
+  tasks.reserve(surfaces.size());
+
+  for (std::size_t idx{0}; idx < surfaces.size(); ++idx) {
+    tasks.push_back(std::make_shared<SurfaceTask>());
+  }
+
+  std::thread{[tasks, surfaces = std::move(surfaces), &pool, settings,
+               priority, cancelled = std::move(cancelled)] {
+    for (std::size_t idx{0}; idx < tasks.size(); ++idx) {
+      if (cancelled->load()) {
+        static_cast<void>(tasks[idx]->cancel());
+        continue;
+      }
+
+      tasks[idx]->price(surfaces[idx], pool, settings, priority);
+    }
+  }}.detach();
+
+  return tasks;
+}
+
+void SurfaceTask::onDone(Callback callback) {
+  {
+    const std::lock_guard lock{mutex_};
+
+    if (!done_) {
+      callbacks_.push_back(std::move(callback));
+      return;
+    }
+  }
+
+  callback(*this);
+}
+
+bool SurfaceTask::done() const {
+  const std::lock_guard lock{mutex_};
+  return done_;
+}
+
+void SurfaceTask::wait() const {
+  std::unique_lock lock{mutex_};
+  finished_.wait(lock, [this] { return done_; });
+}
+
+std::shared_ptr<const SurfaceTask::GridArray> SurfaceTask::grids() const {
+  wait();
+  const std::lock_guard lock{mutex_};
+
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+
+  return grids_;
+}
+
+double SurfaceTask::seconds() const {
+  const std::lock_guard lock{mutex_};
+  return seconds_;
+}
+
+bool SurfaceTask::cancel() {
+  {
+    const std::lock_guard lock{mutex_};
+
+    if (started_) {
+      return false;
+    }
+
+    started_ = true;
+  }
+
+  finish(nullptr,
+         std::make_exception_ptr(std::runtime_error{"Pricing cancelled"}),
+         0.0);
+  return true;
+}
+
+void SurfaceTask::price(const SurfaceSpec& surface,
+                        BS::priority_thread_pool& pool,
+                        const models::trinomial::TreeSettings& settings,
+                        const BS::priority_t priority) {
+  {
+    const std::lock_guard lock{mutex_};
+
+    if (started_) {
+      return;  // cancelled
+    }
+
+    started_ = true;
+  }
+
+  std::shared_ptr<const GridArray> grids{};
+  std::exception_ptr error{};
+  const auto start{std::chrono::steady_clock::now()};
+
+  // The pool isn't used past this block (callbacks may run after whoever owns
+  // it stopped waiting)
+  try {
+    const PricingSurface pricing{surface.sigmas_, surface.strikes_,
+                                 surface.spot_,   surface.r_,
+                                 surface.q_,      surface.tau_,
+                                 pool,            settings,
+                                 priority};
+    grids = std::make_shared<const GridArray>(pricing.calculateGrids());
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                              start};
+  finish(std::move(grids), std::move(error), elapsed.count());
+}
+
+void SurfaceTask::finish(std::shared_ptr<const GridArray> grids,
+                         std::exception_ptr error, const double seconds) {
+  std::vector<Callback> callbacks{};
+
+  {
+    const std::lock_guard lock{mutex_};
+
+    // e.g. a batch member that was cancelled
+    if (done_) {
+      return;
+    }
+
+    started_ = true;
+    grids_ = std::move(grids);
+    error_ = std::move(error);
+    seconds_ = seconds;
+    done_ = true;
+    callbacks.swap(callbacks_);
+  }
+
+  finished_.notify_all();
+
+  // Callbacks run outside the lock so they can query the task
+  for (const Callback& callback : callbacks) {
+    callback(*this);
+  }
+}
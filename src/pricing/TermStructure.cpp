@@ -0,0 +1,53 @@
+#include "OptionsVisualizer/pricing/TermStructure.hpp"
+
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/orchestrate.hpp"
+
+TermStructure::TermStructure(const Eigen::ArrayXd& sigmas,
+                             const Eigen::ArrayXd& strikes, const double spot,
+                             const double r, const double q,
+                             const Eigen::ArrayXd& taus,
+                             BS::priority_thread_pool& pool,
+                             const models::trinomial::TreeSettings& settings)
+    : sigmas_{sigmas},
+      strikes_{strikes},
+      spot_{spot},
+      r_{r},
+      q_{q},
+      taus_{taus},
+      pool_{pool},
+      settings_{settings} {}
+
+std::vector<TermStructure::GridArray> TermStructure::calculateGrids() const {
+  const auto nTaus{static_cast<std::size_t>(taus_.size())};
+
+  if (nTaus == 0) {
+    return {};
+  }
+
+  std::vector<PricingSurface> surfaces{};
+  surfaces.reserve(nTaus);
+
+  for (const double tau : taus_) {
+    surfaces.emplace_back(sigmas_, strikes_, spot_, r_, q_, tau, pool_,
+                          settings_);
+  }
+
+  // Log-moneyness and drift only depend on the axes, spot, r and q
+  const PricingSurface::BsmTerms terms{surfaces.front().bsmTerms()};
+
+  // Each maturity waits on the trees it submits, so maturities are priced
+  // from orchestrating threads (one per pool thread at most) that keep every
+  // remaining maturity's trees queued on the pool
+  return orchestrate(nTaus, pool_.get_thread_count(),
+                     [&surfaces, &terms](const std::size_t idx) {
+                       return surfaces[idx].calculateGrids(terms);
+                     });
+}
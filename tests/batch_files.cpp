@@ -0,0 +1,189 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/batch/BatchJob.hpp"
+#include "OptionsVisualizer/batch/BatchReader.hpp"
+#include "OptionsVisualizer/batch/BatchWriter.hpp"
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Scratch file removed when the test ends
+class TempFile {
+  std::filesystem::path path_;
+
+ public:
+  explicit TempFile(const std::string& name)
+      : path_{std::filesystem::temp_directory_path() /
+              ("options_visualizer_" + name)} {}
+
+  TempFile(const TempFile&) = delete;
+  TempFile& operator=(const TempFile&) = delete;
+
+  ~TempFile() {
+    std::error_code ec{};
+    std::filesystem::remove(path_, ec);
+  }
+
+  [[nodiscard]] std::string path() const { return path_.string(); }
+};
+
+void writeText(const std::string& path, const std::string& text) {
+  std::ofstream{path} << text;
+}
+
+template <typename T>
+[[nodiscard]] T readRaw(std::ifstream& in) {
+  T value{};
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+TEST(BatchFileTests, ReadsSurfacesAndContracts) {
+  const TempFile input{"batch_input.csv"};
+  writeText(input.path(),
+            "# surfaces and contracts\n"
+            "3, 4, 100, 0.05, 0.02, 0.1, 0.4, 80, 120, 1.5\r\n"
+            "\n"
+            "100,95,0.03,0.0,0.25,0.5\n");
+
+  batch::BatchReader reader{input.path()};
+  const std::optional<batch::BatchJob> surface{reader.next()};
+  ASSERT_TRUE(surface.has_value());
+  EXPECT_EQ(surface->index_, 0U);
+  EXPECT_EQ(surface->nSigma_, 3);
+  EXPECT_EQ(surface->nStrike_, 4);
+  EXPECT_EQ(surface->spot_, 100.0);
+  EXPECT_EQ(surface->q_, 0.02);
+  EXPECT_EQ(surface->sigmaHi_, 0.4);
+  EXPECT_EQ(surface->strikeLo_, 80.0);
+  EXPECT_EQ(surface->tau_, 1.5);
+
+  // A contract is a 1 x 1 surface with equal bounds
+  const std::optional<batch::BatchJob> contract{reader.next()};
+  ASSERT_TRUE(contract.has_value());
+  EXPECT_EQ(contract->index_, 1U);
+  EXPECT_EQ(contract->nSigma_, 1);
+  EXPECT_EQ(contract->nStrike_, 1);
+  EXPECT_EQ(contract->strikeLo_, 95.0);
+  EXPECT_EQ(contract->strikeHi_, 95.0);
+  EXPECT_EQ(contract->r_, 0.03);
+  EXPECT_EQ(contract->sigmaLo_, 0.25);
+  EXPECT_EQ(contract->sigmaHi_, 0.25);
+  EXPECT_EQ(contract->tau_, 0.5);
+
+  EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST(BatchFileTests, RejectsInvalidLines) {
+  const TempFile input{"batch_invalid.csv"};
+  const std::vector<std::string> lines{
+      // Grid sizes must be whole, finite and in range
+      "2.7,4,100,0.05,0.02,0.1,0.4,80,120,1",
+      "nan,4,100,0.05,0.02,0.1,0.4,80,120,1",
+      "4,inf,100,0.05,0.02,0.1,0.4,80,120,1",
+      "1e300,4,100,0.05,0.02,0.1,0.4,80,120,1",
+      "99999999999999999999,4,100,0.05,0.02,0.1,0.4,80,120,1",
+      "0,4,100,0.05,0.02,0.1,0.4,80,120,1",
+      // Field counts and values
+      "100,95,0.03,0.0,0.25",
+      "3,4,100,0.05,0.02,0.1,0.4,80,120,1,7",
+      "100,abc,0.03,0.0,0.25,0.5",
+      "100,95,0.03,0.0,nan,0.5",
+      "100,95,0.03,0.0,0.25,-1"};
+
+  for (const std::string& line : lines) {
+    writeText(input.path(), line + '\n');
+    batch::BatchReader reader{input.path()};
+    EXPECT_THROW(static_cast<void>(reader.next()), std::runtime_error)
+        << line;
+  }
+
+  EXPECT_THROW(batch::BatchReader{input.path() + ".missing"},
+               std::runtime_error);
+}
+
+TEST(BatchFileTests, WriterRoundTripsRecords) {
+  const Eigen::Index nSigma{2};
+  const Eigen::Index nStrike{3};
+  GridBlock grids{nSigma, nStrike};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids[idx] = Eigen::ArrayXXd::Random(nSigma, nStrike) +
+                 static_cast<double>(idx);
+  }
+
+  const batch::BatchJob job{.index_ = 7,
+                            .nSigma_ = nSigma,
+                            .nStrike_ = nStrike,
+                            .spot_ = 100.0,
+                            .r_ = 0.05,
+                            .q_ = 0.01,
+                            .sigmaLo_ = 0.1,
+                            .sigmaHi_ = 0.3,
+                            .strikeLo_ = 90.0,
+                            .strikeHi_ = 110.0,
+                            .tau_ = 0.75};
+
+  for (const batch::ValueFormat format :
+       {batch::ValueFormat::Float64, batch::ValueFormat::Float32}) {
+    const TempFile output{"batch_output.bin"};
+
+    {
+      batch::BatchWriter writer{output.path(), format};
+      writer.write(job, grids);
+    }
+
+    std::ifstream in{output.path(), std::ios::binary};
+    char magic[4]{};
+    in.read(magic, 4);
+    EXPECT_EQ(std::string(magic, 4), "OVPB");
+    EXPECT_EQ(readRaw<std::uint32_t>(in), 1U);
+    const auto width{readRaw<std::uint8_t>(in)};
+    EXPECT_EQ(width, format == batch::ValueFormat::Float64 ? sizeof(double)
+                                                           : sizeof(float));
+    EXPECT_EQ(readRaw<std::uint8_t>(in),
+              Enums::idx(Enums::OptionType::COUNT));
+    EXPECT_EQ(readRaw<std::uint8_t>(in), Enums::idx(Enums::GreekType::COUNT));
+
+    EXPECT_EQ(readRaw<std::uint64_t>(in), job.index_);
+    EXPECT_EQ(readRaw<std::int64_t>(in), nSigma);
+    EXPECT_EQ(readRaw<std::int64_t>(in), nStrike);
+
+    for (const double param : {job.spot_, job.r_, job.q_, job.sigmaLo_,
+                               job.sigmaHi_, job.strikeLo_, job.strikeHi_,
+                               job.tau_}) {
+      EXPECT_EQ(readRaw<double>(in), param);
+    }
+
+    // Every grid in column-major order at the file's precision
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      const GridBlock::ConstGrid grid{std::as_const(grids)[idx]};
+
+      for (Eigen::Index cell{0}; cell < grid.size(); ++cell) {
+        if (format == batch::ValueFormat::Float64) {
+          EXPECT_EQ(readRaw<double>(in), grid.data()[cell]);
+        } else {
+          EXPECT_EQ(readRaw<float>(in), static_cast<float>(grid.data()[cell]));
+        }
+      }
+    }
+
+    EXPECT_TRUE(in);
+    EXPECT_EQ(in.peek(), std::ifstream::traits_type::eof());
+  }
+}
@@ -0,0 +1,91 @@
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <cstddef>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+[[nodiscard]] std::size_t gridIdx(const Enums::OptionType optType,
+                                  const Enums::GreekType greekType) {
+  return Enums::idx(optType) * Enums::idx(Enums::GreekType::COUNT) +
+         Enums::idx(greekType);
+}
+
+// Largest absolute difference between two grids relative to the largest
+// magnitude of the expected one
+[[nodiscard]] double relError(const Eigen::Ref<const Eigen::ArrayXXd>& got,
+                              const Eigen::Ref<const Eigen::ArrayXXd>& want) {
+  return (got - want).abs().maxCoeff() / want.abs().maxCoeff();
+}
+
+}  // namespace
+
+TEST(CrossGreeksTests, BsmMatchesBumpedFirstOrderGreeks) {
+  BS::priority_thread_pool pool{2};
+  const Eigen::ArrayXd sigmas{linspace(5, 0.15, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(6, 80.0, 120.0)};
+  const double spot{100.0};
+  const double r{0.05};
+  const double q{0.02};
+  const double tau{0.75};
+  const double sigmaShift{1e-4};
+  const double dTau{1e-5};
+
+  const auto grids{[&](const Eigen::ArrayXd& s, const double t) {
+    return PricingSurface{s, strikes, spot, r, q, t, pool}.calculateGrids();
+  }};
+  const GridBlock base{grids(sigmas, tau)};
+  const GridBlock loSigma{grids(sigmas * (1.0 - sigmaShift), tau)};
+  const GridBlock hiSigma{grids(sigmas * (1.0 + sigmaShift), tau)};
+  const GridBlock loTau{grids(sigmas, tau - dTau)};
+  const GridBlock hiTau{grids(sigmas, tau + dTau)};
+
+  // Central differences of delta and vega over the closed forms (the put's
+  // charm differs from the call's by the dividend term)
+  const Eigen::ArrayXXd dSigma{
+      (sigmas * (2.0 * sigmaShift)).replicate(1, strikes.size())};
+
+  for (const Enums::OptionType optType :
+       {Enums::OptionType::EuroCall, Enums::OptionType::EuroPut}) {
+    const std::size_t delta{gridIdx(optType, Enums::GreekType::Delta)};
+    const std::size_t vega{gridIdx(optType, Enums::GreekType::Vega)};
+    const Eigen::ArrayXXd vanna{(hiSigma[delta] - loSigma[delta]) / dSigma};
+    const Eigen::ArrayXXd volga{(hiSigma[vega] - loSigma[vega]) / dSigma};
+    const Eigen::ArrayXXd charm{-(hiTau[delta] - loTau[delta]) /
+                                (2.0 * dTau)};
+
+    EXPECT_LT(relError(base[gridIdx(optType, Enums::GreekType::Vanna)], vanna),
+              1e-6);
+    EXPECT_LT(relError(base[gridIdx(optType, Enums::GreekType::Volga)], volga),
+              1e-6);
+    EXPECT_LT(relError(base[gridIdx(optType, Enums::GreekType::Charm)], charm),
+              1e-6);
+  }
+}
+
+TEST(CrossGreeksTests, TreeMatchesBsmWithoutEarlyExercise) {
+  // Without dividends the American call is never exercised early, so its
+  // cross greeks from the bumped trees should track the European closed forms
+  BS::priority_thread_pool pool{2};
+  const Eigen::ArrayXd sigmas{linspace(4, 0.2, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(5, 85.0, 115.0)};
+  const PricingSurface surface{
+      sigmas, strikes, 100.0, 0.05, 0.0, 1.0, pool,
+      models::trinomial::TreeSettings{.depth_ = 400, .controlVariate_ = true}};
+  const GridBlock grids{surface.calculateGrids()};
+
+  for (const Enums::GreekType greekType :
+       {Enums::GreekType::Vanna, Enums::GreekType::Volga,
+        Enums::GreekType::Charm}) {
+    EXPECT_LT(relError(grids[gridIdx(Enums::OptionType::AmerCall, greekType)],
+                       grids[gridIdx(Enums::OptionType::EuroCall, greekType)]),
+              0.05)
+        << "greek " << Enums::idx(greekType);
+  }
+}
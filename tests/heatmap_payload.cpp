@@ -0,0 +1,85 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/heatmap.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "gtest/gtest.h"
+
+TEST(HeatmapTests, RangeSpansEveryOptionType) {
+  OptionsManager manager{4, 2};
+  const GridBlock& grids{manager.get(linspace(5, 0.1, 0.5),
+                                     linspace(6, 80.0, 120.0), 100.0, 0.05,
+                                     0.02, 1.0)};
+  const auto greekIdx{Enums::idx(Enums::GreekType::Delta)};
+  double lo{std::numeric_limits<double>::infinity()};
+  double hi{-lo};
+
+  for (std::size_t optIdx{0}; optIdx < Enums::idx(Enums::OptionType::COUNT);
+       ++optIdx) {
+    const GridBlock::ConstGrid grid{
+        grids[optIdx * Enums::idx(Enums::GreekType::COUNT) + greekIdx]};
+    lo = std::min(lo, grid.minCoeff());
+    hi = std::max(hi, grid.maxCoeff());
+  }
+
+  const heatmap::Range range{
+      heatmap::greekRange(grids.view(), Enums::GreekType::Delta)};
+  EXPECT_EQ(range.min_, lo);
+  EXPECT_EQ(range.max_, hi);
+}
+
+TEST(HeatmapTests, CodesDecodeWithinHalfAStep) {
+  GridBlock grids{3, 4};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids[idx] = Eigen::ArrayXXd::Random(3, 4) * static_cast<double>(idx + 1);
+  }
+
+  // Non-finite values are kept out of the range and get their own code
+  const auto priceIdx{Enums::idx(Enums::GreekType::Price)};
+  grids[priceIdx](1, 2) = std::numeric_limits<double>::quiet_NaN();
+  const heatmap::Range range{
+      heatmap::greekRange(grids.view(), Enums::GreekType::Price)};
+  ASSERT_TRUE(std::isfinite(range.min_) && std::isfinite(range.max_));
+
+  const heatmap::Quantization q{heatmap::quantization<std::uint8_t>(range)};
+  std::vector<std::uint8_t> codes(12);
+  heatmap::quantize(std::as_const(grids)[priceIdx], q, codes.data());
+
+  for (Eigen::Index idx{0}; idx < 12; ++idx) {
+    const double value{std::as_const(grids)[priceIdx].data()[idx]};
+    const std::uint8_t code{codes[static_cast<std::size_t>(idx)]};
+
+    if (std::isnan(value)) {
+      EXPECT_EQ(code, heatmap::nonFinite<std::uint8_t>);
+    } else {
+      EXPECT_LT(code, heatmap::nonFinite<std::uint8_t>);
+      EXPECT_NEAR(q.offset_ + q.scale_ * code, value, q.scale_ / 2.0 + 1e-12);
+    }
+  }
+
+  // Constant greeks decode to their minimum
+  for (std::size_t optIdx{0}; optIdx < Enums::idx(Enums::OptionType::COUNT);
+       ++optIdx) {
+    grids[optIdx * Enums::idx(Enums::GreekType::COUNT) + priceIdx]
+        .setConstant(2.5);
+  }
+
+  const heatmap::Quantization flat{heatmap::quantization<std::uint16_t>(
+      heatmap::greekRange(grids.view(), Enums::GreekType::Price))};
+  EXPECT_EQ(flat.scale_, 0.0);
+
+  std::vector<float> narrowed(12);
+  heatmap::narrow(std::as_const(grids)[priceIdx], narrowed.data());
+  EXPECT_EQ(narrowed[5], 2.5F);
+}
@@ -0,0 +1,120 @@
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/pricing/Portfolio.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "gtest/gtest.h"
+
+TEST(PortfolioTests, TotalsMatchPositionsPricedAlone) {
+  const std::vector<Portfolio::Position> positions{
+      {.optType_ = Enums::OptionType::AmerPut,
+       .strike_ = 95.0,
+       .tau_ = 0.5,
+       .quantity_ = 10.0},
+      {.optType_ = Enums::OptionType::EuroCall,
+       .strike_ = 105.0,
+       .tau_ = 0.5,
+       .quantity_ = -4.0},
+      {.optType_ = Enums::OptionType::AmerCall,
+       .strike_ = 100.0,
+       .tau_ = 1.0,
+       .quantity_ = 3.0},
+      {.optType_ = Enums::OptionType::EuroPut,
+       .strike_ = 95.0,
+       .tau_ = 1.0,
+       .quantity_ = 2.5}};
+  const double spot{100.0};
+  const double r{0.04};
+  const double q{0.01};
+  const double sigma{0.25};
+  const Eigen::ArrayXd spotShocks{{-0.1, 0.0, 0.05}};
+  const Eigen::ArrayXd volShocks{{-0.05, 0.0, 0.1}};
+
+  BS::priority_thread_pool pool{2};
+  const Portfolio::Scenarios scenarios{
+      Portfolio{positions, spot, r, q, sigma, pool}.revalue(spotShocks,
+                                                            volShocks)};
+  const std::size_t nGreeks{Portfolio::nGreeks};
+  const std::size_t priceIdx{Enums::idx(Enums::GreekType::Price)};
+  ASSERT_EQ(scenarios.pnl_.rows(), spotShocks.size());
+  ASSERT_EQ(scenarios.pnl_.cols(), volShocks.size());
+
+  // Sum of each position priced on its own single-cell surface
+  const auto bookTotal{[&](const double s, const double vol,
+                           const std::size_t greekIdx) {
+    double total{0.0};
+
+    for (const Portfolio::Position& position : positions) {
+      const PricingSurface surface{
+          Eigen::ArrayXd::Constant(1, vol),
+          Eigen::ArrayXd::Constant(1, position.strike_),
+          s,
+          r,
+          q,
+          position.tau_,
+          pool};
+      const GridBlock grids{surface.calculateGrids()};
+      total += position.quantity_ *
+               grids[Enums::idx(position.optType_) * nGreeks + greekIdx](0, 0);
+    }
+
+    return total;
+  }};
+  const double baseValue{bookTotal(spot, sigma, priceIdx)};
+
+  for (Eigen::Index row{0}; row < spotShocks.size(); ++row) {
+    for (Eigen::Index col{0}; col < volShocks.size(); ++col) {
+      const double s{spot * (1.0 + spotShocks[row])};
+      const double vol{sigma + volShocks[col]};
+
+      for (std::size_t greekIdx{0}; greekIdx < nGreeks; ++greekIdx) {
+        const double expected{bookTotal(s, vol, greekIdx)};
+        EXPECT_NEAR(scenarios.totals_[greekIdx](row, col), expected,
+                    1e-9 * std::max(1.0, std::abs(expected)))
+            << "greek " << greekIdx;
+      }
+
+      EXPECT_NEAR(scenarios.pnl_(row, col),
+                  bookTotal(s, vol, priceIdx) - baseValue, 1e-9);
+    }
+  }
+
+  // The unshocked scenario is the base market
+  EXPECT_NEAR(scenarios.pnl_(1, 1), 0.0, 1e-12);
+}
+
+TEST(PortfolioTests, OffsettingPositionsNetOut) {
+  OptionsManager manager{4, 2};
+  const std::vector<Portfolio::Position> positions{
+      {.optType_ = Enums::OptionType::AmerCall,
+       .strike_ = 100.0,
+       .tau_ = 0.75,
+       .quantity_ = 5.0},
+      {.optType_ = Enums::OptionType::AmerCall,
+       .strike_ = 100.0,
+       .tau_ = 0.75,
+       .quantity_ = -5.0}};
+  const Portfolio::Scenarios scenarios{
+      manager.revalue(positions, 100.0, 0.03, 0.0, 0.2,
+                      Eigen::ArrayXd{{-0.2, 0.2}}, Eigen::ArrayXd{{0.0, 0.1}})};
+
+  EXPECT_TRUE((scenarios.pnl_ == 0.0).all());
+
+  for (const Eigen::ArrayXXd& total : scenarios.totals_) {
+    EXPECT_TRUE((total == 0.0).all());
+  }
+
+  // Shocks can't push the spot or vol to zero or below
+  EXPECT_THROW(static_cast<void>(manager.revalue(
+                   positions, 100.0, 0.03, 0.0, 0.2, Eigen::ArrayXd{{-1.0}},
+                   Eigen::ArrayXd{{0.0}})),
+               std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+#include <Eigen/Dense>
+#include <stdexcept>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/pricing/PricingParams.hpp"
+#include "gtest/gtest.h"
+
+TEST(PricingAxesTests, SpacingsKeepBoundsAndOrder) {
+  using Enums::AxisSpacing;
+
+  for (const AxisSpacing spacing :
+       {AxisSpacing::Linear, AxisSpacing::Log, AxisSpacing::Chebyshev}) {
+    const Eigen::ArrayXd axis{makeAxis(spacing, 9, 0.1, 0.9)};
+    ASSERT_EQ(axis.size(), 9);
+    EXPECT_EQ(axis(0), 0.1);
+    EXPECT_EQ(axis(8), 0.9);
+    EXPECT_TRUE((axis.tail(8) > axis.head(8)).all());
+  }
+
+  // Log spacing is denser at the low end, Chebyshev at both ends
+  const Eigen::ArrayXd logAxis{makeAxis(AxisSpacing::Log, 9, 0.1, 0.9)};
+  EXPECT_LT(logAxis(1) - logAxis(0), logAxis(8) - logAxis(7));
+  const Eigen::ArrayXd chebAxis{makeAxis(AxisSpacing::Chebyshev, 9, 0.1, 0.9)};
+  EXPECT_LT(chebAxis(1) - chebAxis(0), chebAxis(5) - chebAxis(4));
+  EXPECT_NEAR(chebAxis(4), 0.5, 1e-15);
+
+  EXPECT_THROW(static_cast<void>(logspace(3, 0.0, 1.0)),
+               std::invalid_argument);
+}
+
+TEST(PricingAxesTests, CacheKeysFollowAxisContents) {
+  const Eigen::ArrayXd sigmas{linspace(4, 0.1, 0.4)};
+  const Eigen::ArrayXd strikes{linspace(3, 80.0, 120.0)};
+
+  // Explicit axes matching linspace share the key of the bounds-only form
+  const PricingParams bounds{4, 3, 100.0, 0.05, 0.02, 0.1, 0.4, 80.0, 120.0,
+                             1.0};
+  EXPECT_TRUE((PricingParams{sigmas, strikes, 100.0, 0.05, 0.02, 1.0} ==
+               bounds));
+  EXPECT_EQ(PricingParamsHash{}(
+                PricingParams{sigmas, strikes, 100.0, 0.05, 0.02, 1.0}),
+            PricingParamsHash{}(bounds));
+
+  // Same bounds and size but different interior points
+  const Eigen::ArrayXd chebStrikes{chebspace(3, 80.0, 120.0)};
+  const Eigen::ArrayXd skewedStrikes{{80.0, 90.0, 120.0}};
+  EXPECT_TRUE((PricingParams{sigmas, chebStrikes, 100.0, 0.05, 0.02, 1.0} ==
+               bounds));
+  EXPECT_FALSE((PricingParams{sigmas, skewedStrikes, 100.0, 0.05, 0.02, 1.0} ==
+                bounds));
+
+  // Surfaces over explicit axes are priced on exactly those points
+  OptionsManager manager{2, 1};
+  const auto& grids{
+      manager.get(sigmas, skewedStrikes, 100.0, 0.05, 0.02, 1.0)};
+  const auto& column{manager.get(
+      sigmas, Eigen::ArrayXd::Constant(1, 90.0), 100.0, 0.05, 0.02, 1.0)};
+  EXPECT_TRUE(grids[0].col(1).isApprox(column[0].col(0), 1e-14));
+  EXPECT_EQ(manager.cacheStats().misses_, 2U);
+
+  static_cast<void>(manager.get(4, 3, 100.0, 0.05, 0.02, 0.1, 0.4, 80.0, 120.0,
+                                1.0));
+  static_cast<void>(manager.get(sigmas, strikes, 100.0, 0.05, 0.02, 1.0));
+  EXPECT_EQ(manager.cacheStats().hits_, 1U);
+}
@@ -0,0 +1,54 @@
+#include <Eigen/Dense>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/pricing/ProgressiveSurface.hpp"
+#include "gtest/gtest.h"
+
+TEST(ProgressiveSurfaceTests, RefinesToTheFullSurface) {
+  using Stage = ProgressiveSurface::Stage;
+  const Eigen::ArrayXd sigmas{linspace(9, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(9, 80.0, 120.0)};
+  OptionsManager manager{ManagerConfig{.capacity_ = 2,
+                                       .nThreads_ = 2,
+                                       .previewStride_ = 4,
+                                       .previewDepth_ = 10}};
+
+  // Nothing is ready on the first call
+  OptionsManager::Progress progress{
+      manager.getProgressive(sigmas, strikes, 100.0, 0.05, 0.02, 1.0)};
+  EXPECT_EQ(progress.stage_, Stage::Pending);
+  EXPECT_EQ(progress.grids_, nullptr);
+
+  // Stages only move forward and always cover the full grid
+  Stage seen{progress.stage_};
+
+  while (progress.stage_ != Stage::Final) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    progress = manager.getProgressive(sigmas, strikes, 100.0, 0.05, 0.02, 1.0);
+    EXPECT_GE(progress.stage_, seen);
+    seen = progress.stage_;
+
+    if (progress.grids_ != nullptr) {
+      EXPECT_EQ((*progress.grids_)[0].rows(), 9);
+      EXPECT_EQ((*progress.grids_)[0].cols(), 9);
+    }
+  }
+
+  // The final stage is the regular surface and now lives in the cache
+  OptionsManager reference{2, 1};
+  const auto& expected{reference.get(sigmas, strikes, 100.0, 0.05, 0.02, 1.0)};
+  const auto& actual{manager.get(sigmas, strikes, 100.0, 0.05, 0.02, 1.0)};
+  EXPECT_EQ(&actual, progress.grids_);
+
+  for (std::size_t idx{0}; idx < globals::nGrids;
+       idx += Enums::idx(Enums::GreekType::COUNT)) {
+    EXPECT_TRUE((actual[idx] == expected[idx]).all());
+  }
+}
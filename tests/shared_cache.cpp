@@ -0,0 +1,170 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/ipc/SharedCache.hpp"
+#include "OptionsVisualizer/ipc/SharedGrids.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingParams.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+using GridArray = GridBlock;
+
+// Unique cache name per test so parallel runs don't collide
+[[nodiscard]] std::string cacheName(const std::string& test) {
+  return "/ovtest-" + std::to_string(::getpid()) + "-" + test;
+}
+
+[[nodiscard]] GridArray makeGrids(const double seed) {
+  GridArray grids{3, 2};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids[idx] =
+        Eigen::ArrayXXd::Constant(3, 2, seed + static_cast<double>(idx));
+  }
+
+  return grids;
+}
+
+[[nodiscard]] PricingParams makeParams(const double spot) {
+  return PricingParams{3, 2, spot, 0.05, 0.02, 0.1, 0.4, 80.0, 120.0, 1.0};
+}
+
+}  // namespace
+
+TEST(SharedCacheTests, PublishedResultsAreVisibleToOtherHandles) {
+  const std::string name{cacheName("visible")};
+
+  {
+    ipc::SharedCache writer{name, 4};
+    ipc::SharedCache reader{name, 4};
+    const GridArray grids{makeGrids(1.0)};
+
+    EXPECT_FALSE(reader.find(makeParams(100.0)).has_value());
+    static_cast<void>(writer.publish(makeParams(100.0), grids));
+
+    const std::optional<ipc::SharedGrids> found{
+        reader.find(makeParams(100.0))};
+    ASSERT_TRUE(found.has_value());
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      EXPECT_TRUE(found->grid(idx).isApprox(grids[idx]));
+    }
+  }
+
+  ipc::SharedCache::destroy(name);
+}
+
+TEST(SharedCacheTests, ResultsAreScopedToTreeSettings) {
+  const std::string name{cacheName("settings")};
+
+  {
+    ipc::SharedCache shallow{name, 4,
+                             models::trinomial::TreeSettings{.depth_ = 50}};
+    ipc::SharedCache deep{name, 4,
+                          models::trinomial::TreeSettings{.depth_ = 400}};
+    ipc::SharedCache corrected{
+        name, 4,
+        models::trinomial::TreeSettings{.depth_ = 50, .controlVariate_ = true}};
+    static_cast<void>(shallow.publish(makeParams(100.0), makeGrids(1.0)));
+
+    EXPECT_TRUE(shallow.find(makeParams(100.0)).has_value());
+    EXPECT_FALSE(deep.find(makeParams(100.0)).has_value());
+    EXPECT_FALSE(corrected.find(makeParams(100.0)).has_value());
+
+    // The partitions only split the work, so they share results
+    ipc::SharedCache partitioned{
+        name, 4,
+        models::trinomial::TreeSettings{.depth_ = 50, .partitions_ = 4}};
+    EXPECT_TRUE(partitioned.find(makeParams(100.0)).has_value());
+  }
+
+  ipc::SharedCache::destroy(name);
+}
+
+TEST(SharedCacheTests, InvalidSegmentsAreMisses) {
+  const std::string name{cacheName("invalid")};
+
+  {
+    ipc::SharedCache cache{name, 4};
+    static_cast<void>(cache.publish(makeParams(100.0), makeGrids(1.0)));
+
+    // Clobber the first segment's magic as if it had another layout
+    const int fd{::shm_open((name + "-0").c_str(), O_RDWR, 0)};
+    ASSERT_NE(fd, -1);
+    const std::uint32_t garbage{0};
+    ASSERT_EQ(::pwrite(fd, &garbage, sizeof(garbage), 0),
+              static_cast<ssize_t>(sizeof(garbage)));
+    ::close(fd);
+
+    EXPECT_FALSE(cache.find(makeParams(100.0)).has_value());
+
+    // The stale entry was dropped, so the results can be published again
+    static_cast<void>(cache.publish(makeParams(100.0), makeGrids(2.0)));
+    const std::optional<ipc::SharedGrids> found{
+        cache.find(makeParams(100.0))};
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->grid(0)(0, 0), 2.0);
+  }
+
+  ipc::SharedCache::destroy(name);
+}
+
+TEST(SharedCacheTests, EvictsLeastRecentlyUsedEntry) {
+  const std::string name{cacheName("evict")};
+
+  {
+    ipc::SharedCache cache{name, 2};
+    static_cast<void>(cache.publish(makeParams(100.0), makeGrids(1.0)));
+    static_cast<void>(cache.publish(makeParams(101.0), makeGrids(2.0)));
+
+    // Touch the first entry so the second is the eviction candidate
+    EXPECT_TRUE(cache.find(makeParams(100.0)).has_value());
+    static_cast<void>(cache.publish(makeParams(102.0), makeGrids(3.0)));
+
+    EXPECT_TRUE(cache.find(makeParams(100.0)).has_value());
+    EXPECT_FALSE(cache.find(makeParams(101.0)).has_value());
+    EXPECT_TRUE(cache.find(makeParams(102.0)).has_value());
+  }
+
+  ipc::SharedCache::destroy(name);
+}
+
+TEST(SharedCacheTests, SegmentsShareTheGridBlockLayout) {
+  const std::string name{cacheName("layout")};
+  const GridArray grids{makeGrids(1.0)};
+  const GridBlock::View block{grids.view()};
+
+  // One cache-line aligned allocation with padded, cache-line aligned grids
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.data_) %
+                GridBlock::alignment,
+            0U);
+  EXPECT_EQ(block.gridStride_, 8);
+  EXPECT_EQ(grids[1].data(), block.data_ + block.gridStride_);
+
+  // Copies are deep
+  GridArray copy{grids};
+  copy[0](0, 0) = -1.0;
+  EXPECT_EQ(grids[0](0, 0), 1.0);
+
+  // A segment maps the same tensor (so it's exported the same way)
+  const ipc::SharedGrids segment{ipc::SharedGrids::create(name, grids)};
+  const GridBlock::View mapped{segment.view()};
+  EXPECT_EQ(mapped.nSigma_, 3);
+  EXPECT_EQ(mapped.nStrike_, 2);
+  EXPECT_EQ(mapped.gridStride_, block.gridStride_);
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    EXPECT_TRUE((mapped.grid(idx) == grids[idx]).all());
+  }
+}
@@ -0,0 +1,94 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <functional>
+#include <limits>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/lru/CompressedGrids.hpp"
+#include "OptionsVisualizer/lru/SurfaceCache.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+using Cache = SurfaceCache<int, int, std::hash<int>>;
+
+// Look a key up and store it on a miss (mirrors OptionsManager::get)
+void access(Cache& cache, const int key, const double cost) {
+  if (cache.find(key) == nullptr) {
+    cache.set(key, int{key}, cost);
+  }
+}
+
+}  // namespace
+
+TEST(SurfaceCacheTests, LruEvictsLeastRecentlyUsed) {
+  Cache cache{2, Enums::CachePolicy::LRU};
+  access(cache, 1, 1.0);
+  access(cache, 2, 1.0);
+  access(cache, 1, 1.0);
+  access(cache, 3, 1.0);
+
+  EXPECT_NE(cache.find(1), nullptr);
+  EXPECT_EQ(cache.find(2), nullptr);
+  EXPECT_NE(cache.find(3), nullptr);
+  EXPECT_EQ(cache.stats().evictions_, 1U);
+}
+
+TEST(SurfaceCacheTests, TinyLfuKeepsPopularExpensiveEntries) {
+  constexpr std::size_t capacity{10};
+  Cache cache{capacity, Enums::CachePolicy::TinyLFU};
+
+  // Popular, expensive surfaces requested repeatedly
+  for (int round{0}; round < 3; ++round) {
+    for (int key{0}; key < static_cast<int>(capacity); ++key) {
+      access(cache, key, 1.0);
+    }
+  }
+
+  // A burst of cheap one-off requests shouldn't flush them
+  for (int key{100}; key < 200; ++key) {
+    access(cache, key, 0.01);
+  }
+
+  cache.resetStats();
+
+  for (int key{0}; key < static_cast<int>(capacity) - 1; ++key) {
+    static_cast<void>(cache.find(key));
+  }
+
+  EXPECT_GE(cache.stats().hits_, capacity - 2);
+}
+
+TEST(SurfaceCacheTests, CompressedGridsStayWithinTolerance) {
+  constexpr double tolerance{1e-4};
+  const Eigen::ArrayXXd sigmas{linspace(12, 0.1, 0.4).replicate(1, 12)};
+  const Eigen::ArrayXXd strikes{
+      linspace(12, 80.0, 120.0).transpose().replicate(12, 1)};
+  GridBlock grids{12, 12};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    grids[idx] = (strikes * sigmas).sqrt() * static_cast<double>(idx + 1);
+  }
+
+  // Grids with NaNs are kept exactly
+  grids[1](3, 4) = std::numeric_limits<double>::quiet_NaN();
+
+  const CompressedGrids compressed{grids, tolerance};
+  const auto restored{compressed.decompress()};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    if (idx == 1) {
+      EXPECT_TRUE(restored[idx].isNaN()(3, 4));
+      continue;
+    }
+
+    EXPECT_LE((restored[idx] - grids[idx]).abs().maxCoeff(),
+              tolerance * grids[idx].abs().maxCoeff());
+  }
+
+  // Smooth grids quantize to 16 bits (a quarter of the raw doubles)
+  EXPECT_LT(compressed.size(), globals::nGrids * 144 * sizeof(double) / 3);
+}
@@ -0,0 +1,275 @@
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "OptionsVisualizer/pricing/SurfaceBatch.hpp"
+#include "OptionsVisualizer/pricing/SurfaceSpec.hpp"
+#include "OptionsVisualizer/pricing/SurfaceTask.hpp"
+#include "gtest/gtest.h"
+
+TEST(SurfaceTaskTests, SubmittedSurfacesMatchGet) {
+  const Eigen::ArrayXd sigmas{linspace(6, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(7, 80.0, 120.0)};
+  const double taus[]{0.5, 1.0};
+  OptionsManager manager{ManagerConfig{.capacity_ = 4, .nThreads_ = 2}};
+
+  // Both surfaces are priced concurrently, identical submissions share a task
+  const std::shared_ptr<SurfaceTask> first{
+      manager.submit(sigmas, strikes, 100.0, 0.05, 0.02, taus[0])};
+  const std::shared_ptr<SurfaceTask> second{
+      manager.submit(sigmas, strikes, 100.0, 0.05, 0.02, taus[1])};
+  EXPECT_EQ(manager.submit(sigmas, strikes, 100.0, 0.05, 0.02, taus[0]),
+            first);
+
+  std::atomic<int> notified{0};
+  first->onDone([&notified](const SurfaceTask& task) {
+    EXPECT_TRUE(task.done());
+    ++notified;
+  });
+  second->wait();
+  first->wait();
+  EXPECT_EQ(notified.load(), 1);
+
+  // Callbacks registered after the fact run right away
+  first->onDone([&notified](const SurfaceTask&) { ++notified; });
+  EXPECT_EQ(notified.load(), 2);
+
+  // Finished submissions move into the cache (no pricing on the next `get`)
+  OptionsManager reference{4, 1};
+  manager.resetCacheStats();
+
+  for (std::size_t idx{0}; idx < 2; ++idx) {
+    const auto& grids{*(idx == 0 ? first : second)->grids()};
+    const auto& expected{
+        reference.get(sigmas, strikes, 100.0, 0.05, 0.02, taus[idx])};
+    const auto& cached{
+        manager.get(sigmas, strikes, 100.0, 0.05, 0.02, taus[idx])};
+
+    for (std::size_t grid{0}; grid < globals::nGrids;
+         grid += Enums::idx(Enums::GreekType::COUNT)) {
+      EXPECT_TRUE((grids[grid] == expected[grid]).all());
+      EXPECT_TRUE((cached[grid] == expected[grid]).all());
+    }
+  }
+
+  EXPECT_EQ(manager.cacheStats().hits_, 2U);
+
+  // Cached surfaces come back finished
+  EXPECT_TRUE(
+      manager.submit(sigmas, strikes, 100.0, 0.05, 0.02, taus[1])->done());
+}
+
+TEST(SurfaceTaskTests, ConcurrentCallsMatchGet) {
+  const Eigen::ArrayXd sigmas{linspace(5, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(6, 80.0, 120.0)};
+  const double taus[]{0.25, 0.5, 0.75};
+  const std::size_t nTaus{std::size(taus)};
+  const std::size_t nCallers{4};
+  OptionsManager manager{ManagerConfig{.capacity_ = 8, .nThreads_ = 2}};
+
+  // Every caller submits and gets every surface (starting at a different one),
+  // so identical requests overlap
+  std::vector<std::vector<std::shared_ptr<SurfaceTask>>> submitted(nCallers);
+  std::vector<std::vector<GridBlock>> fetched(nCallers);
+
+  {
+    std::vector<std::jthread> callers{};
+
+    for (std::size_t caller{0}; caller < nCallers; ++caller) {
+      callers.emplace_back([&, caller] {
+        for (std::size_t idx{0}; idx < nTaus; ++idx) {
+          const double tau{taus[(caller + idx) % nTaus]};
+          submitted[caller].push_back(
+              manager.submit(sigmas, strikes, 100.0, 0.05, 0.02, tau));
+          fetched[caller].push_back(
+              manager.get(sigmas, strikes, 100.0, 0.05, 0.02, tau));
+        }
+      });
+    }
+  }  // join the callers
+
+  OptionsManager reference{8, 1};
+
+  for (std::size_t caller{0}; caller < nCallers; ++caller) {
+    for (std::size_t idx{0}; idx < nTaus; ++idx) {
+      const double tau{taus[(caller + idx) % nTaus]};
+      const auto& expected{
+          reference.get(sigmas, strikes, 100.0, 0.05, 0.02, tau)};
+      const auto& grids{*submitted[caller][idx]->grids()};
+
+      for (std::size_t grid{0}; grid < globals::nGrids; ++grid) {
+        EXPECT_TRUE((grids[grid] == expected[grid]).all());
+        EXPECT_TRUE((fetched[caller][idx][grid] == expected[grid]).all());
+      }
+    }
+  }
+}
+
+TEST(SurfaceTaskTests, BatchesMatchSeparateSurfaces) {
+  // Overlapping ranges, a different resolution and a duplicate surface
+  const std::vector<SurfaceBatch::Axes> members{
+      {.sigmas_ = linspace(6, 0.1, 0.5), .strikes_ = linspace(5, 80.0, 120.0)},
+      {.sigmas_ = linspace(3, 0.1, 0.3), .strikes_ = linspace(9, 80.0, 120.0)},
+      {.sigmas_ = linspace(4, 0.2, 0.6), .strikes_ = linspace(2, 90.0, 95.0)},
+      {.sigmas_ = linspace(6, 0.1, 0.5), .strikes_ = linspace(5, 80.0, 120.0)},
+  };
+  BS::priority_thread_pool pool{2};
+  const std::vector<GridBlock> batch{
+      SurfaceBatch::price(members, 100.0, 0.05, 0.02, 0.75, pool, {})};
+  ASSERT_EQ(batch.size(), members.size());
+
+  for (std::size_t member{0}; member < members.size(); ++member) {
+    const PricingSurface surface{members[member].sigmas_,
+                                 members[member].strikes_,
+                                 100.0,
+                                 0.05,
+                                 0.02,
+                                 0.75,
+                                 pool};
+    const GridBlock expected{surface.calculateGrids()};
+    ASSERT_EQ(batch[member].rows(), expected.rows());
+    ASSERT_EQ(batch[member].cols(), expected.cols());
+
+    for (std::size_t grid{0}; grid < globals::nGrids; ++grid) {
+      EXPECT_TRUE(batch[member][grid].isApprox(expected[grid], 1e-12))
+          << "member " << member << ", grid " << grid;
+    }
+  }
+}
+
+TEST(SurfaceTaskTests, CoalescedSubmissionsMatchGet) {
+  const Eigen::ArrayXd sigmas[]{linspace(6, 0.1, 0.5), linspace(4, 0.3, 0.7)};
+  const Eigen::ArrayXd strikes{linspace(7, 80.0, 120.0)};
+  OptionsManager manager{
+      ManagerConfig{.capacity_ = 4, .nThreads_ = 2, .coalesceMs_ = 50.0}};
+
+  // Both surfaces join the same batch
+  const std::shared_ptr<SurfaceTask> tasks[]{
+      manager.submit(sigmas[0], strikes, 100.0, 0.05, 0.02, 0.5),
+      manager.submit(sigmas[1], strikes, 100.0, 0.05, 0.02, 0.5)};
+  EXPECT_EQ(manager.submit(sigmas[0], strikes, 100.0, 0.05, 0.02, 0.5),
+            tasks[0]);
+
+  OptionsManager reference{4, 1};
+
+  for (std::size_t idx{0}; idx < 2; ++idx) {
+    const auto& grids{*tasks[idx]->grids()};
+    const auto& expected{
+        reference.get(sigmas[idx], strikes, 100.0, 0.05, 0.02, 0.5)};
+
+    for (std::size_t grid{0}; grid < globals::nGrids; ++grid) {
+      EXPECT_TRUE(grids[grid].isApprox(expected[grid], 1e-12));
+    }
+  }
+
+  // Finished batches move into the cache like any other submission
+  manager.resetCacheStats();
+  static_cast<void>(manager.get(sigmas[1], strikes, 100.0, 0.05, 0.02, 0.5));
+  EXPECT_EQ(manager.cacheStats().hits_, 1U);
+}
+
+TEST(SurfaceTaskTests, WarmupFillsTheCache) {
+  const Eigen::ArrayXd sigmas{linspace(6, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(7, 80.0, 120.0)};
+  const double spots[]{100.0, 101.0};
+  ManagerConfig config{.capacity_ = 4, .nThreads_ = 2};
+
+  for (const double spot : spots) {
+    config.warmup_.push_back(SurfaceSpec{.sigmas_ = sigmas,
+                                         .strikes_ = strikes,
+                                         .spot_ = spot,
+                                         .r_ = 0.05,
+                                         .q_ = 0.02,
+                                         .tau_ = 0.5});
+  }
+
+  OptionsManager manager{config};
+
+  while (manager.warmingUp()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+
+  // Warmed surfaces are cache hits
+  OptionsManager reference{4, 1};
+
+  for (const double spot : spots) {
+    const auto& grids{manager.get(sigmas, strikes, spot, 0.05, 0.02, 0.5)};
+    const auto& expected{
+        reference.get(sigmas, strikes, spot, 0.05, 0.02, 0.5)};
+
+    for (std::size_t grid{0}; grid < globals::nGrids; ++grid) {
+      EXPECT_TRUE((grids[grid] == expected[grid]).all());
+    }
+  }
+
+  EXPECT_EQ(manager.cacheStats().hits_, 2U);
+  EXPECT_EQ(manager.cacheStats().misses_, 0U);
+
+  // Destroying a manager cancels the warm-up instead of finishing it
+  config.warmup_.resize(64, config.warmup_.front());
+  const auto start{std::chrono::steady_clock::now()};
+  {
+    const OptionsManager cancelled{config};
+  }
+
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+}
+
+TEST(SurfaceTaskTests, RequestsTakeOverWarmup) {
+  const Eigen::ArrayXd sigmas{linspace(6, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(7, 80.0, 120.0)};
+  ManagerConfig config{.capacity_ = 32, .nThreads_ = 2};
+
+  for (std::size_t idx{0}; idx < 16; ++idx) {
+    const double spot{90.0 + static_cast<double>(idx)};
+    config.warmup_.push_back(SurfaceSpec{.sigmas_ = sigmas,
+                                         .strikes_ = strikes,
+                                         .spot_ = spot,
+                                         .r_ = 0.05,
+                                         .q_ = 0.02,
+                                         .tau_ = 0.5});
+  }
+
+  OptionsManager manager{config};
+  OptionsManager reference{4, 1};
+
+  // The last warm-up surface hasn't started (it's priced by the request) while
+  // the first one has (the request waits on it)
+  for (const double spot : {105.0, 90.0}) {
+    const auto& grids{manager.get(sigmas, strikes, spot, 0.05, 0.02, 0.5)};
+    const auto& expected{
+        reference.get(sigmas, strikes, spot, 0.05, 0.02, 0.5)};
+
+    for (std::size_t grid{0}; grid < globals::nGrids; ++grid) {
+      EXPECT_TRUE((grids[grid] == expected[grid]).all());
+    }
+  }
+
+  while (manager.warmingUp()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+
+  // Both were cached once, along with the rest of the warm-up
+  manager.resetCacheStats();
+
+  for (std::size_t idx{0}; idx < 16; ++idx) {
+    static_cast<void>(manager.get(sigmas, strikes,
+                                  90.0 + static_cast<double>(idx), 0.05, 0.02,
+                                  0.5));
+  }
+
+  EXPECT_EQ(manager.cacheStats().hits_, 16U);
+}
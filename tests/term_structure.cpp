@@ -0,0 +1,63 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "gtest/gtest.h"
+
+TEST(TermStructureTests, CubeMatchesSeparateMaturities) {
+  const Eigen::ArrayXd sigmas{linspace(5, 0.1, 0.5)};
+  const Eigen::ArrayXd strikes{linspace(6, 80.0, 120.0)};
+  const Eigen::ArrayXd taus{{0.25, 0.5, 1.0, 2.0}};
+  OptionsManager manager{ManagerConfig{.capacity_ = 8, .nThreads_ = 2}};
+  OptionsManager reference{8, 1};
+
+  const std::vector<GridBlock> cube{
+      manager.getCube(sigmas, strikes, 100.0, 0.05, 0.02, taus)};
+  ASSERT_EQ(cube.size(), static_cast<std::size_t>(taus.size()));
+
+  for (Eigen::Index tau{0}; tau < taus.size(); ++tau) {
+    const GridBlock& grids{cube[static_cast<std::size_t>(tau)]};
+    const GridBlock& expected{
+        reference.get(sigmas, strikes, 100.0, 0.05, 0.02, taus[tau])};
+    ASSERT_EQ(grids.rows(), sigmas.size());
+    ASSERT_EQ(grids.cols(), strikes.size());
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      EXPECT_TRUE((grids[idx] == expected[idx]).all());
+    }
+  }
+}
+
+TEST(TermStructureTests, CubeReusesCachedMaturities) {
+  const Eigen::ArrayXd sigmas{linspace(4, 0.1, 0.4)};
+  const Eigen::ArrayXd strikes{linspace(4, 90.0, 110.0)};
+  const Eigen::ArrayXd taus{{0.5, 1.0, 1.5}};
+  OptionsManager manager{ManagerConfig{.capacity_ = 8, .nThreads_ = 2}};
+
+  // One maturity is already cached, the other two are priced and cached
+  const GridBlock single{
+      manager.get(sigmas, strikes, 100.0, 0.03, 0.0, taus[1])};
+  manager.resetCacheStats();
+  const std::vector<GridBlock> cube{
+      manager.getCube(sigmas, strikes, 100.0, 0.03, 0.0, taus)};
+  EXPECT_EQ(manager.cacheStats().hits_, 1U);
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    EXPECT_TRUE((cube[1][idx] == single[idx]).all());
+  }
+
+  manager.resetCacheStats();
+  static_cast<void>(manager.getCube(sigmas, strikes, 100.0, 0.03, 0.0, taus));
+  EXPECT_EQ(manager.cacheStats().hits_, 3U);
+  EXPECT_EQ(manager.cacheStats().misses_, 0U);
+
+  // No maturities at all
+  EXPECT_TRUE(
+      manager.getCube(sigmas, strikes, 100.0, 0.03, 0.0, Eigen::ArrayXd{})
+          .empty());
+}
@@ -0,0 +1,74 @@
+#include <BS_thread_pool.hpp>
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/GridBlock.hpp"
+#include "OptionsVisualizer/core/ManagerConfig.hpp"
+#include "OptionsVisualizer/core/OptionsManager.hpp"
+#include "OptionsVisualizer/core/Topology.hpp"
+#include "OptionsVisualizer/core/globals.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/tree_settings.hpp"
+#include "OptionsVisualizer/pricing/PricingSurface.hpp"
+#include "gtest/gtest.h"
+
+TEST(ThreadAffinityTests, ThreadsAlternateBetweenNodes) {
+  using Enums::ThreadAffinity;
+  const std::vector<std::vector<int>> nodes{{0, 1, 2}, {8, 9}};
+
+  EXPECT_TRUE(Utils::threadCpus(ThreadAffinity::Off, nodes, 3).empty());
+
+  // Consecutive threads land on different nodes and wrap around their CPUs
+  const std::vector<std::vector<int>> cores{{0}, {8}, {1}, {9}, {2}, {8}};
+
+  for (std::size_t idx{0}; idx < cores.size(); ++idx) {
+    EXPECT_EQ(Utils::threadCpus(ThreadAffinity::Core, nodes, idx), cores[idx]);
+  }
+
+  EXPECT_EQ(Utils::threadCpus(ThreadAffinity::Node, nodes, 2), nodes[0]);
+  EXPECT_EQ(Utils::threadCpus(ThreadAffinity::Node, nodes, 3), nodes[1]);
+
+  // This machine's topology covers at least one CPU
+  const std::vector<std::vector<int>> local{Utils::numaNodes()};
+  ASSERT_FALSE(local.empty());
+  EXPECT_FALSE(local.front().empty());
+}
+
+TEST(ThreadAffinityTests, PartitionedSurfacesMatch) {
+  const Eigen::ArrayXd sigmas{linspace(16, 0.1, 0.6)};
+  const Eigen::ArrayXd strikes{linspace(13, 70.0, 130.0)};
+  BS::priority_thread_pool pool{2};
+
+  const GridBlock whole{
+      PricingSurface{sigmas, strikes, 100.0, 0.05, 0.02, 0.75, pool}
+          .calculateGrids()};
+
+  // Uneven blocks of strike columns (and more blocks than the surface has
+  // room for) price the same cells
+  for (const Eigen::Index partitions : {3, 64}) {
+    const GridBlock split{
+        PricingSurface{sigmas, strikes, 100.0, 0.05, 0.02, 0.75, pool,
+                       models::trinomial::TreeSettings{.partitions_ =
+                                                           partitions}}
+            .calculateGrids()};
+
+    for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+      EXPECT_TRUE((split[idx] == whole[idx]).all());
+    }
+  }
+
+  // Pinned pools price the same surfaces too
+  OptionsManager manager{
+      ManagerConfig{.capacity_ = 2,
+                    .nThreads_ = 2,
+                    .affinity_ = Enums::ThreadAffinity::Core,
+                    .tree_ = {.partitions_ = 0}}};
+  const GridBlock& pinned{
+      manager.get(sigmas, strikes, 100.0, 0.05, 0.02, 0.75)};
+
+  for (std::size_t idx{0}; idx < globals::nGrids; ++idx) {
+    EXPECT_TRUE((pinned[idx] == whole[idx]).all());
+  }
+}
@@ -0,0 +1,213 @@
+#include <Eigen/Dense>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+#include "OptionsVisualizer/core/Enums.hpp"
+#include "OptionsVisualizer/core/linspace.hpp"
+#include "OptionsVisualizer/models/bsm/calculate_price.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/calculate_price.hpp"
+#include "OptionsVisualizer/models/trinomial/internal/node_update.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Small grid of sigma x strike values shared by the kernel tests
+struct KernelGrid {
+  static constexpr Eigen::Index nSigma{11};
+  static constexpr Eigen::Index nStrike{5};
+  static constexpr double spot{100.0};
+  static constexpr double r{0.05};
+  static constexpr double q{0.02};
+  static constexpr double tau{1.0};
+  Eigen::ArrayXXd sigmasGrid{
+      linspace(nSigma, 0.1, 0.6).replicate(1, nStrike)};
+  Eigen::ArrayXXd strikesGrid{
+      linspace(nStrike, 80.0, 120.0).transpose().replicate(nSigma, 1)};
+};
+
+}  // namespace
+
+TEST(TrinomialKernelTests, FixedDepthMatchesDynamicDepth) {
+  using Enums::OptionType;
+  const KernelGrid g{};
+  constexpr Eigen::Index depth{50};
+  const models::trinomial::TreeSettings settings{.depth_ = depth};
+  Eigen::ArrayXXd fixed{g.nSigma, g.nStrike};
+  Eigen::ArrayXXd dynamic{g.nSigma, g.nStrike};
+
+  models::trinomial::internal::priceGrid<OptionType::AmerPut, depth, 4>(
+      g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, settings, fixed);
+  models::trinomial::internal::priceGrid<OptionType::AmerPut, Eigen::Dynamic,
+                                         4>(g.spot, g.r, g.q, g.sigmasGrid,
+                                            g.strikesGrid, g.tau, settings,
+                                            dynamic);
+
+  EXPECT_TRUE(fixed.isApprox(dynamic, 1e-14));
+}
+
+TEST(TrinomialKernelTests, TileHeightDoesNotChangePrices) {
+  using Enums::OptionType;
+  const KernelGrid g{};
+
+  // Whole grid (padded tiles) against pricing each cell on its own
+  const Eigen::ArrayXXd grid{
+      models::trinomial::calculatePrice<OptionType::AmerCall>(
+          g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau)};
+
+  for (Eigen::Index col{0}; col < g.nStrike; ++col) {
+    for (Eigen::Index row{0}; row < g.nSigma; ++row) {
+      const Eigen::ArrayXXd cell{
+          models::trinomial::calculatePrice<OptionType::AmerCall>(
+              g.spot, g.r, g.q, g.sigmasGrid.block(row, col, 1, 1),
+              g.strikesGrid.block(row, col, 1, 1), g.tau)};
+      EXPECT_NEAR(grid(row, col), cell(0, 0), 1e-12);
+    }
+  }
+}
+
+TEST(TrinomialKernelTests, TruncatedLatticeStaysWithinTolerance) {
+  using Enums::OptionType;
+  const KernelGrid g{};
+  const models::trinomial::TreeSettings full{.truncation_ = 0.0};
+  const models::trinomial::TreeSettings truncated{.truncation_ = 6.0};
+
+  // Nodes beyond 6 standard deviations carry negligible probability mass
+  for (const auto& [fullPrices, truncatedPrices] :
+       {std::pair{models::trinomial::calculatePrice<OptionType::AmerCall>(
+                      g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau,
+                      full),
+                  models::trinomial::calculatePrice<OptionType::AmerCall>(
+                      g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau,
+                      truncated)},
+        std::pair{models::trinomial::calculatePrice<OptionType::AmerPut>(
+                      g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau,
+                      full),
+                  models::trinomial::calculatePrice<OptionType::AmerPut>(
+                      g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau,
+                      truncated)}}) {
+    EXPECT_LT((fullPrices - truncatedPrices).abs().maxCoeff(), 1e-8);
+  }
+
+  // A tight window visibly changes prices (so the window is actually applied)
+  const models::trinomial::TreeSettings tight{.truncation_ = 1.0};
+  const Eigen::ArrayXXd tightPrices{
+      models::trinomial::calculatePrice<OptionType::AmerPut>(
+          g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, tight)};
+  const Eigen::ArrayXXd fullPrices{
+      models::trinomial::calculatePrice<OptionType::AmerPut>(
+          g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, full)};
+  EXPECT_GT((fullPrices - tightPrices).abs().maxCoeff(), 1e-6);
+
+  EXPECT_THROW(static_cast<void>(
+                   models::trinomial::calculatePrice<OptionType::AmerPut>(
+                       g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau,
+                       models::trinomial::TreeSettings{.truncation_ = -1.0})),
+               std::invalid_argument);
+}
+
+TEST(TrinomialKernelTests, ExerciseSkipMatchesFullRollback) {
+  using Enums::OptionType;
+
+  // Deep in-the-money puts with a high rate have a wide exercise region
+  const Eigen::ArrayXXd sigmasGrid{linspace(8, 0.1, 0.6).replicate(1, 4)};
+  const Eigen::ArrayXXd strikesGrid{
+      linspace(4, 100.0, 200.0).transpose().replicate(8, 1)};
+  constexpr double spot{100.0};
+  constexpr double r{0.1};
+  constexpr double q{0.0};
+  constexpr double tau{2.0};
+
+  const Eigen::ArrayXXd skipped{
+      models::trinomial::calculatePrice<OptionType::AmerPut>(
+          spot, r, q, sigmasGrid, strikesGrid, tau,
+          models::trinomial::TreeSettings{.skipExercise_ = true})};
+  const Eigen::ArrayXXd full{
+      models::trinomial::calculatePrice<OptionType::AmerPut>(
+          spot, r, q, sigmasGrid, strikesGrid, tau,
+          models::trinomial::TreeSettings{.skipExercise_ = false})};
+
+  EXPECT_TRUE(skipped.isApprox(full, 1e-13));
+}
+
+TEST(TrinomialKernelTests, SimdKernelsMatchGenericKernel) {
+  using models::trinomial::internal::NodeCoefficients;
+  using models::trinomial::internal::SimdLevel;
+  constexpr int tile{8};
+  constexpr Eigen::Index nNodes{41};
+
+  const Eigen::Array<double, tile, 1> pU{
+      Eigen::Array<double, tile, 1>::LinSpaced(0.15, 0.2)};
+  const Eigen::Array<double, tile, 1> pD{1.0 / 3.0 - pU};
+  const Eigen::Array<double, tile, 1> pM{1.0 - pU - pD};
+  const Eigen::Array<double, tile, 1> strikes{
+      Eigen::Array<double, tile, 1>::LinSpaced(80.0, 120.0)};
+  const Eigen::Array<double, tile, nNodes + 2> spots{
+      100.0 * Eigen::Array<double, tile, nNodes + 2>::Random().exp()};
+  const Eigen::Array<double, tile, nNodes + 2> values{
+      Eigen::Array<double, tile, nNodes + 2>::Random().abs() * 20.0};
+
+  const NodeCoefficients coefficients{.pU_ = pU.data(),
+                                      .pM_ = pM.data(),
+                                      .pD_ = pD.data(),
+                                      .strikes_ = strikes.data(),
+                                      .discountFactor_ = 0.999};
+
+  // Every instruction set must reproduce the portable kernel bit for bit
+  const auto check{[&]<Enums::OptionType OptType>() {
+    Eigen::Array<double, tile, nNodes + 2> expected{values};
+    models::trinomial::internal::rollBackKernel<OptType, tile>(
+        SimdLevel::Generic)(coefficients, expected.data(), spots.data(), 0,
+                            nNodes - 1);
+
+    for (const SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+      if (level > models::trinomial::internal::detectSimdLevel()) {
+        continue;
+      }
+
+      Eigen::Array<double, tile, nNodes + 2> actual{values};
+      models::trinomial::internal::rollBackKernel<OptType, tile>(level)(
+          coefficients, actual.data(), spots.data(), 0, nNodes - 1);
+      EXPECT_TRUE((actual == expected).all());
+    }
+  }};
+
+  check.template operator()<Enums::OptionType::AmerCall>();
+  check.template operator()<Enums::OptionType::AmerPut>();
+  check.template operator()<Enums::OptionType::EuroPut>();
+}
+
+TEST(TrinomialKernelTests, ControlVariateReducesDiscretizationError) {
+  using Enums::OptionType;
+  const KernelGrid g{};
+  const models::trinomial::TreeSettings reference{.depth_ = 1000};
+  const models::trinomial::TreeSettings plain{.depth_ = 25};
+  const models::trinomial::TreeSettings corrected{.depth_ = 25,
+                                                  .controlVariate_ = true};
+
+  const Eigen::ArrayXXd exact{
+      models::trinomial::calculatePrice<OptionType::AmerPut>(
+          g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, reference)};
+  const double plainError{
+      (models::trinomial::calculatePrice<OptionType::AmerPut>(
+           g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, plain) -
+       exact)
+          .abs()
+          .maxCoeff()};
+  const double correctedError{
+      (models::trinomial::calculatePrice<OptionType::AmerPut>(
+           g.spot, g.r, g.q, g.sigmasGrid, g.strikesGrid, g.tau, corrected) -
+       exact)
+          .abs()
+          .maxCoeff()};
+  EXPECT_LT(correctedError, plainError / 3.0);
+
+  // Without dividends an American call is never exercised early, so the
+  // corrected price is the BSM price itself
+  const Eigen::ArrayXXd call{
+      models::trinomial::calculatePrice<OptionType::AmerCall>(
+          g.spot, g.r, 0.0, g.sigmasGrid, g.strikesGrid, g.tau, corrected)};
+  const Eigen::ArrayXXd bsm{models::bsm::calculatePrice<OptionType::EuroCall>(
+      g.spot, g.r, 0.0, g.sigmasGrid, g.strikesGrid, g.tau)};
+  EXPECT_TRUE(call.isApprox(bsm, 1e-12));
+}